@@ -0,0 +1,114 @@
+/*
+    FRAM Write Combining
+    --------------------
+    Header file name - "Fram_Write_Combine.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Single byte writes to contiguous addresses are collected in RAM and sent
+    as one sequential write transaction:
+      START + SLA+W + word address + data... + STOP
+    so bus overhead is paid once per run instead of once per byte.
+    Buffer is flushed when:
+      - FRAM_Combine_Flush() is called
+      - buffer is full (FRAM_COMBINE_SIZE bytes), at once by the write
+        which fills it
+      - next address is not contiguous with buffered run
+      - slave address or word address type changed since buffering
+
+    Flush returns 0 on bus error and keeps the run buffered, so it can be
+    retried. FRAM_Write_Combined() returns 0 (byte not taken) when the run
+    it had to flush could not be written. A failed flush of the run it has
+    just filled keeps the byte (counted in Combine_Errors), the full run is
+    flushed again by next write or FRAM_Combine_Flush().
+
+    NOTES: Buffered bytes are not in FRAM until flushed. Read them back with
+           FRAM_Read_Combined(), or call FRAM_Combine_Flush() before using
+           FRAM_Read()/FRAM_Read_Array() and before i2cMaster_Disable().
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_WRITE_COMBINE_H
+#define FRAM_WRITE_COMBINE_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#define FRAM_COMBINE_SIZE   32      // Buffer size in bytes
+
+uint8_t Combine_Buf[FRAM_COMBINE_SIZE];
+uint8_t Combine_Count = 0;          // Buffered bytes
+uint16_t Combine_Adr = 0;           // Word address of first buffered byte
+FramDevice Combine_Dev;             // Device of buffered run
+
+// Statistics
+unsigned long Combine_Bytes = 0;    // Bytes written through combining
+unsigned long Combine_Flushes = 0;  // Transactions sent
+unsigned long Combine_Errors = 0;   // Flushes failed, run kept in buffer
+
+
+// Send buffered run as one sequential write transaction
+// Returns 0 if write failed, run stays buffered for next flush
+bool FRAM_Combine_Flush(void) {
+  if (Combine_Count == 0) return 1;
+
+  if (!FRAM_Write_Buffer(Combine_Dev, Combine_Adr, Combine_Buf, Combine_Count)) {
+    Combine_Errors++;
+    return 0;
+  }
+
+  Combine_Count = 0;
+  Combine_Flushes++;
+  return 1;
+}
+
+// Returns 0 if byte is not taken (buffered run could not be flushed)
+bool FRAM_Write_Combined(FramDevice& dev, uint16_t word_adr, uint8_t data) {
+  // Flush if new byte cannot extend the buffered run
+  // (full run is left only after its flush failed)
+  if (Combine_Count > 0) {
+    if (Combine_Count == FRAM_COMBINE_SIZE ||
+        word_adr != (uint16_t)(Combine_Adr + Combine_Count) ||
+        Combine_Dev.sla_wr != dev.sla_wr || Combine_Dev.adr_type != dev.adr_type) {
+      if (!FRAM_Combine_Flush()) return 0;
+    }
+  }
+
+  // Start new run
+  if (Combine_Count == 0) {
+    Combine_Adr = word_adr;
+    Combine_Dev = dev;
+  }
+
+  Combine_Buf[Combine_Count++] = data;
+  Combine_Bytes++;
+
+  // Full, send at once instead of waiting for next write
+  if (Combine_Count == FRAM_COMBINE_SIZE) {
+    FRAM_Combine_Flush();
+  }
+  return 1;
+}
+
+// Read byte, served from buffer if it is not flushed yet
+char FRAM_Read_Combined(FramDevice& dev, uint16_t word_adr) {
+  if (Combine_Count > 0 && Combine_Dev.sla_wr == dev.sla_wr &&
+      (uint16_t)(word_adr - Combine_Adr) < Combine_Count) {
+    return Combine_Buf[word_adr - Combine_Adr];
+  }
+  return FRAM_Read(dev, word_adr);
+}
+
+// Without device, use current i2cMaster_Init() and FRAM_Word_Adr() settings
+bool FRAM_Write_Combined(uint16_t word_adr, uint8_t data) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Write_Combined(dev, word_adr, data);
+}
+
+char FRAM_Read_Combined(uint16_t word_adr) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Read_Combined(dev, word_adr);
+}
+
+#endif
@@ -0,0 +1,278 @@
+/*
+    FRAM I2C Benchmark
+    ------------------
+    Description:
+    1. Ready gating: operations per second of FRAM_Write, FRAM_Write_Array,
+       FRAM_Read and FRAM_Read_Array, measured twice:
+         - legacy: with the old fixed I2C_Shift_Sec (10 ms) wait before each call
+         - ready : with bus-ready gating in i2cMaster_Start() (current driver)
+    2. Bus-time accounting: for each SCL frequency in Bench_Speed[], validate
+       write/read-back, then run every API BENCH_OPS times and report per call
+         - START, REPEAT and STOP conditions
+         - bytes on the wire (slave address + word address + data)
+         - bus time calculated from SCL frequency (9 clocks per byte,
+           1 per START/REPEAT/STOP)
+         - wall time measured with Timer1
+         - effective payload throughput (payload bytes per second)
+       Bus traffic is counted by the driver itself (I2C_BUS_STATS).
+
+    Tested Boards: Arduino UNO, Nano (Atmega328p MCU)
+    MCU Clock: 16 MHz
+    Tested I2C Device: MB85RC256V FRAM (16-bit word address)
+
+    The same sketch runs on the host simulator ("host_sim"), where Timer1 and
+    the bus are simulated, so numbers from both can be compared directly.
+
+    *****************************************************************************
+    **Notes - Contents of the benchmark area (BENCH_WORD_ADR onwards) will be  **
+    **        overwritten.                                                     **
+    *****************************************************************************
+    **Caution - Timer1 is reconfigured as stopwatch, PWM on pins 9/10 and      **
+    **          libraries using Timer1 (e.g. Servo) do not work with it.       **
+    *****************************************************************************
+
+    Date: 17 Oct 2026
+*/
+
+#define I2C_BUS_STATS                 // Count bus traffic in driver
+#include "Fram_Rx_Tx_Operation.h"
+#include "Fram_Write_Combine.h"
+
+#define BENCH_FRAM_ADR        0x50
+#define BENCH_ADR_TYPE        1       // 0 = 8-bit, 1 = 16-bit word address
+#define BENCH_WORD_ADR        0x0100  // Start of benchmark area
+#define BENCH_OPS             100     // Operations per measurement
+#define BENCH_ARRAY_LEN       16      // Bytes per array operation
+#define BENCH_BUFFER_LEN      128     // Bytes per sequential buffer operation
+
+// Timer1 stopwatch, prescaler 8 -> 0.5 us per tick at 16 MHz
+// One call must be shorter than 65535 ticks (32 ms at 16 MHz)
+#define T1_PRESCALER          8
+
+#define OP_WRITE              0
+#define OP_WRITE_ARRAY        1
+#define OP_READ               2
+#define OP_READ_ARRAY         3
+#define OP_WRITE_BUFFER       4
+#define OP_READ_BUFFER        5
+#define OP_WRITE_COMBINED     6
+#define OP_COUNT              7
+
+// SCL frequencies for bus speed test
+const uint32_t Bench_Speed[] = {100000, 200000, 400000};
+#define BENCH_SPEEDS          (sizeof(Bench_Speed) / sizeof(Bench_Speed[0]))
+
+const char* const Op_Name[] = {
+  "FRAM_Write      ",
+  "FRAM_Write_Array",
+  "FRAM_Read       ",
+  "FRAM_Read_Array ",
+  "FRAM_Write_Buf  ",
+  "FRAM_Read_Buf   ",
+  "Write_Combined  "
+};
+
+// Payload bytes moved by one call
+const uint16_t Op_Payload[] = {
+  1, BENCH_ARRAY_LEN, 1, BENCH_ARRAY_LEN,
+  BENCH_BUFFER_LEN, BENCH_BUFFER_LEN, BENCH_ARRAY_LEN
+};
+
+char wr[BENCH_ARRAY_LEN + 1];
+char rd[BENCH_ARRAY_LEN + 1];
+uint8_t blk[BENCH_BUFFER_LEN];
+
+// Old driver behaviour: fixed time shift before every operation
+void Legacy_Shift_Wait(void) {
+  Current_Sec = Ref_Sec;
+  while (!(Ref_Sec - Current_Sec > I2C_Shift_Sec)) {}
+}
+
+void Timer1_Start(void) {
+  TCCR1A = 0;
+  TCCR1B = (1 << CS11);       // Prescaler 8
+  TCNT1 = 0;
+}
+
+// One call of benchmarked operation
+// Single bytes go to every other address, so FRAM_Read never starts at the
+// address latch of the call before and always sends the word address
+// (current-address reads are not what is measured here).
+void Bench_Op(uint8_t op, uint16_t n) {
+  uint16_t adr = BENCH_WORD_ADR + ((n * 2) & 0x0F);
+
+  switch (op) {
+    case OP_WRITE:
+      FRAM_Write(adr, (uint8_t)n);
+      break;
+    case OP_WRITE_ARRAY:
+      FRAM_Write_Array(BENCH_WORD_ADR, wr);
+      break;
+    case OP_READ:
+      FRAM_Read(adr);
+      break;
+    case OP_READ_ARRAY:
+      FRAM_Read_Array(BENCH_WORD_ADR, rd, BENCH_ARRAY_LEN);
+      break;
+    case OP_WRITE_BUFFER:
+      FRAM_Write_Buffer(BENCH_WORD_ADR, blk, BENCH_BUFFER_LEN);
+      break;
+    case OP_READ_BUFFER:
+      FRAM_Read_Buffer(BENCH_WORD_ADR, blk, BENCH_BUFFER_LEN);
+      break;
+    case OP_WRITE_COMBINED:
+      for (uint8_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+        FRAM_Write_Combined(BENCH_WORD_ADR + i, wr[i]);
+      }
+      FRAM_Combine_Flush();
+      break;
+  }
+}
+
+// Returns elapsed micro seconds for BENCH_OPS operations
+unsigned long Bench_Run(uint8_t op, bool legacy) {
+  unsigned long start = micros();
+
+  for (uint16_t n = 0; n < BENCH_OPS; n++) {
+    if (legacy) {
+      Legacy_Shift_Wait();
+    }
+    Bench_Op(op, n);
+  }
+
+  return micros() - start;
+}
+
+// Returns Timer1 ticks for BENCH_OPS operations, timed one by one
+unsigned long Bench_Timed(uint8_t op) {
+  unsigned long ticks = 0;
+
+  for (uint16_t n = 0; n < BENCH_OPS; n++) {
+    Timer1_Start();
+    Bench_Op(op, n);
+    ticks += TCNT1;
+  }
+
+  return ticks;
+}
+
+unsigned long Ops_Per_Sec(unsigned long us) {
+  if (us == 0) return 0;
+  return ((unsigned long)BENCH_OPS * 1000000UL) / us;
+}
+
+// Write pattern, read back and compare
+bool Bench_Verify(uint8_t seed) {
+  for (uint16_t i = 0; i < BENCH_BUFFER_LEN; i++) {
+    blk[i] = (uint8_t)(i * 7 + seed);      // Binary, contains '\0'
+  }
+  FRAM_Write_Buffer(BENCH_WORD_ADR, blk, BENCH_BUFFER_LEN);
+  memset(blk, 0, BENCH_BUFFER_LEN);
+  FRAM_Read_Buffer(BENCH_WORD_ADR, blk, BENCH_BUFFER_LEN);
+
+  for (uint16_t i = 0; i < BENCH_BUFFER_LEN; i++) {
+    if (blk[i] != (uint8_t)(i * 7 + seed)) return 0;
+  }
+  return 1;
+}
+
+void Bench_Gating(void) {
+  Serial.println("--- Ready gating ---");
+  Serial.println("Function          legacy ops/s  ready ops/s");
+
+  for (uint8_t op = OP_WRITE; op <= OP_READ_ARRAY; op++) {
+    unsigned long legacy_us = Bench_Run(op, true);
+    unsigned long ready_us = Bench_Run(op, false);
+
+    Serial.print(Op_Name[op]);
+    Serial.print("  ");
+    Serial.print(Ops_Per_Sec(legacy_us));
+    Serial.print("\t\t");
+    Serial.println(Ops_Per_Sec(ready_us));
+  }
+  Serial.println();
+}
+
+void Bench_Accounting(uint32_t scl_freq) {
+  bool reachable = i2cMaster_Init(BENCH_FRAM_ADR, scl_freq);
+  FRAM_Word_Adr(BENCH_ADR_TYPE);
+  uint32_t scl = i2cMaster_Get_Speed();
+
+  Serial.print("--- SCL ");
+  Serial.print(scl);
+  Serial.print(" Hz (TWBR ");
+  Serial.print(I2C_TWBR);
+  Serial.print(", TWPS ");
+  Serial.print(I2C_TWPS);
+  Serial.print(reachable ? ")" : ", requested speed not reachable)");
+  Serial.print(", verify ");
+  Serial.println(Bench_Verify(I2C_TWBR) ? "OK ---" : "FAIL ---");
+  Serial.println("Function          payload start rep stop wire  bus us  wall us  payload B/s");
+
+  for (uint8_t op = 0; op < OP_COUNT; op++) {
+    I2C_Stats_t before = I2C_Stats;
+    unsigned long ticks = Bench_Timed(op);
+
+    // Per call averages
+    unsigned long start = (I2C_Stats.start - before.start) / BENCH_OPS;
+    unsigned long repeat = (I2C_Stats.repeat - before.repeat) / BENCH_OPS;
+    unsigned long stop = (I2C_Stats.stop - before.stop) / BENCH_OPS;
+    unsigned long wire = (I2C_Stats.bytes - before.bytes) / BENCH_OPS;
+    unsigned long clocks = wire * 9 + start + repeat + stop;
+    unsigned long bus_us = (unsigned long)((float)clocks * 1000000.0 / scl);
+    float wall_us = (float)ticks * T1_PRESCALER / (F_CPU / 1000000UL) / BENCH_OPS;
+    unsigned long rate = (wall_us > 0) ? (unsigned long)(Op_Payload[op] * 1000000.0 / wall_us) : 0;
+
+    Serial.print(Op_Name[op]);
+    Serial.print("  ");
+    Serial.print(Op_Payload[op]);
+    Serial.print("\t");
+    Serial.print(start);
+    Serial.print("     ");
+    Serial.print(repeat);
+    Serial.print("   ");
+    Serial.print(stop);
+    Serial.print("    ");
+    Serial.print(wire);
+    Serial.print("\t");
+    Serial.print(bus_us);
+    Serial.print("\t");
+    Serial.print(wall_us, 1);
+    Serial.print("\t");
+    Serial.println(rate);
+  }
+  Serial.println();
+}
+
+void setup() {
+  Serial.begin(9600);
+  Serial.println("+++Start Benchmark+++");
+
+  // Non-zero pattern, FRAM_Write_Array stops at '\0'
+  for (uint8_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+    wr[i] = 'A' + i;
+  }
+  wr[BENCH_ARRAY_LEN] = '\0';
+
+  Serial.print("F_CPU: ");
+  Serial.println(F_CPU);
+  Serial.print("Ops per test: ");
+  Serial.println(BENCH_OPS);
+  Serial.println();
+
+  // 1. Ready gating at default speed
+  i2cMaster_Init(BENCH_FRAM_ADR, SCL_FREQ);
+  FRAM_Word_Adr(BENCH_ADR_TYPE);
+  Bench_Gating();
+
+  // 2. Bus-time accounting at each speed
+  for (uint8_t n = 0; n < BENCH_SPEEDS; n++) {
+    Bench_Accounting(Bench_Speed[n]);
+  }
+
+  Serial.println("+++End Benchmark+++");
+}
+
+void loop() {
+
+}
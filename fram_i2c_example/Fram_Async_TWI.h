@@ -0,0 +1,362 @@
+/*
+    FRAM Asynchronous TWI Engine
+    ----------------------------
+    Header file name - "Fram_Async_TWI.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Interrupt driven FRAM read/write. Transactions are put into a queue and
+    executed in background by TWI interrupt (ISR(TWI_vect)) state machine,
+    so CPU is not blocked while bytes are shifting on the bus.
+    Each transaction is a FramAsync_Txn owned by the caller, which is also
+    the status handle. It can be polled with FRAM_Async_Status() or waited
+    with FRAM_Async_Wait(), and an optional callback is called on completion.
+
+    NOTES: - Transaction memory (FramAsync_Txn and data buffer) must stay valid
+             until status is FRAM_ASYNC_DONE or FRAM_ASYNC_ERROR.
+           - Callback runs inside TWI interrupt. Keep it short, it may submit
+             new transactions but must not call blocking FRAM functions.
+           - Blocking FRAM functions can be mixed, i2cMaster_Start() waits
+             until the queue is drained.
+           - Slave address and word address type are taken from FramDevice,
+             or from current i2cMaster_Init() and FRAM_Word_Adr() settings
+             when no device is given, at submit time.
+           - Transfers are not split at 256-byte pages of 8-bit word address
+             devices, they rely on the chip rolling over into the next page
+             (FM24CL16B does).
+           - FRAM_Async_Wait() gives up when no TWI interrupt came within the
+             longest stage budget of "Master_TWI.h" (I2C_TIMEOUT_BYTES byte
+             times at current bus speed), same as blocking functions.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_ASYNC_TWI_H
+#define FRAM_ASYNC_TWI_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#define FRAM_ASYNC_QUEUE_SIZE   8     // Queue slots, must be power of 2
+
+//**************** Transaction Status ******************//
+#define FRAM_ASYNC_QUEUED       0     // Waiting in queue
+#define FRAM_ASYNC_BUSY         1     // Running on the bus
+#define FRAM_ASYNC_DONE         2     // Finished successfully
+#define FRAM_ASYNC_ERROR        3     // Finished with error, see error/twsr
+
+#define FRAM_ASYNC_WRITE        0
+#define FRAM_ASYNC_READ         1
+
+//**************** Error Status Code ******************//
+#define ASYNC_TWSR_not_reach    0x21  // Unexpected TWSR status code (saved in twsr)
+#define ASYNC_dead_loop         0x22  // No TWI interrupt within stage budget (FRAM_Async_Timeout_us())
+#define ASYNC_LEN_invalid       0x23  // Zero length transaction
+
+struct FramAsync_Txn;
+typedef void (*FramAsync_Callback)(FramAsync_Txn* txn);
+
+struct FramAsync_Txn {
+  uint8_t sla_wr;                 // Slave write address (read address = sla_wr | 1)
+  uint8_t adr_bytes;              // 1 = 8-bit, 2 = 16-bit word address
+  uint16_t word_adr;
+  uint8_t* buf;
+  uint16_t len;
+  uint8_t dir;                    // FRAM_ASYNC_WRITE or FRAM_ASYNC_READ
+  volatile uint8_t status;        // FRAM_ASYNC_QUEUED ... FRAM_ASYNC_ERROR
+  volatile uint8_t error;         // Error status code
+  volatile uint8_t twsr;          // TWSR status when error occurred
+  FramAsync_Callback callback;    // Optional, called from TWI interrupt
+};
+
+FramAsync_Txn* volatile Async_Queue[FRAM_ASYNC_QUEUE_SIZE];
+volatile uint8_t Async_Head = 0;        // Running transaction
+volatile uint8_t Async_Tail = 0;        // Next free slot
+volatile uint8_t Async_Progress = 0;    // Counted on every TWI interrupt
+
+// Bus step state of running transaction (used only inside interrupt)
+uint16_t Async_Index = 0;
+uint8_t Async_Adr_Left = 0;
+
+// TWI interrupt enabled, clear TWINT to continue
+#define TWCR_ASYNC    ((1 << TWINT) | (1 << TWEN) | (1 << TWIE))
+
+void FRAM_Async_Drain(void);
+
+
+// Start running transaction at queue head
+// STOP of previous transaction is sent in the same TWCR write when needed
+void Async_Begin(uint8_t stop_first)
+{
+  FramAsync_Txn* txn = Async_Queue[Async_Head];
+  txn->status = FRAM_ASYNC_BUSY;
+  Async_Index = 0;
+  Async_Adr_Left = txn->adr_bytes;
+
+  TWCR = TWCR_ASYNC | (1 << TWSTA) |
+         (stop_first ? (1 << TWSTO) : 0);
+  if (stop_first) I2C_STAT(stop);
+  I2C_STAT(start);
+}
+
+// Complete running transaction and continue with next one
+void Async_Finish(uint8_t status, uint8_t error, uint8_t twsr)
+{
+  FramAsync_Txn* txn = Async_Queue[Async_Head];
+  Async_Head = (Async_Head + 1) & (FRAM_ASYNC_QUEUE_SIZE - 1);
+
+  txn->error = error;
+  txn->twsr = twsr;
+  txn->status = status;
+  I2C_TRACE_ERROR(error);
+  I2C_TRACE_TXN(status == FRAM_ASYNC_DONE);
+  if (txn->callback) {
+    txn->callback(txn);
+  }
+
+  if (Async_Head != Async_Tail) {
+    Async_Begin(1);
+  }
+  else {
+    TWCR = (1 << TWINT) | (1 << TWEN) |
+           (1 << TWSTO);    // STOP, TWI interrupt disabled
+    I2C_STAT(stop);
+    I2C_Bus_State = I2C_READY;
+  }
+}
+
+
+/*
+    TWI Interrupt State Machine
+    ---------------------------
+    Write: START -> SLA+W -> word address -> data... -> STOP
+    Read : START -> SLA+W -> word address -> REPEAT -> SLA+R
+           -> data (ACK)... -> last data (NACK) -> STOP
+*/
+ISR(TWI_vect)
+{
+  FramAsync_Txn* txn = Async_Queue[Async_Head];
+  uint8_t twsr = TWSR & 0xF8;
+  Async_Progress++;
+
+  // Every interrupt except START/REPEAT follows one byte on the wire
+  if (twsr != TWI_START && twsr != TWI_REP_START) I2C_STAT(bytes);
+
+  switch (twsr) {
+    case TWI_START:
+      TWDR = txn->sla_wr;
+      TWCR = TWCR_ASYNC;
+      break;
+
+    case TWI_REP_START:
+      TWDR = txn->sla_wr | (1 << RW_BIT);
+      TWCR = TWCR_ASYNC;
+      break;
+
+    case TWI_MTX_ADR_ACK:
+    case TWI_MTX_DATA_ACK:
+      if (Async_Adr_Left > 0) {
+        // Word address, high byte first
+        TWDR = (Async_Adr_Left == 2) ? (uint8_t)(txn->word_adr >> 8) :
+               (uint8_t)(txn->word_adr & 0xFF);
+        Async_Adr_Left--;
+        TWCR = TWCR_ASYNC;
+      }
+      else if (txn->dir == FRAM_ASYNC_READ) {
+        TWCR = TWCR_ASYNC | (1 << TWSTA);     // REPEAT condition
+        I2C_STAT(repeat);
+      }
+      else if (Async_Index < txn->len) {
+        TWDR = txn->buf[Async_Index++];
+        TWCR = TWCR_ASYNC;
+      }
+      else {
+        Async_Finish(FRAM_ASYNC_DONE, 0, twsr);
+      }
+      break;
+
+    case TWI_MRX_ADR_ACK:
+      // ACK every byte except last one
+      TWCR = TWCR_ASYNC | ((txn->len > 1) ? (1 << TWEA) : 0);
+      break;
+
+    case TWI_MRX_DATA_ACK:
+      txn->buf[Async_Index++] = TWDR;
+      TWCR = TWCR_ASYNC | ((Async_Index < txn->len - 1) ? (1 << TWEA) : 0);
+      break;
+
+    case TWI_MRX_DATA_NACK:
+      txn->buf[Async_Index++] = TWDR;
+      Async_Finish(FRAM_ASYNC_DONE, 0, twsr);
+      break;
+
+    default:
+      // NACK from slave, arbitration lost or bus error
+      Async_Finish(FRAM_ASYNC_ERROR, ASYNC_TWSR_not_reach, twsr);
+      break;
+  }
+}
+
+
+// Put transaction into queue, returns 0 if queue is full
+bool FRAM_Async_Submit(FramAsync_Txn* txn)
+{
+  if (txn->len == 0) {
+    txn->error = ASYNC_LEN_invalid;
+    I2C_TRACE_ERROR(ASYNC_LEN_invalid);
+    txn->status = FRAM_ASYNC_ERROR;
+    return 0;
+  }
+
+  // Register drain function for blocking FRAM functions
+  I2C_Async_Drain = FRAM_Async_Drain;
+
+  // Let blocking STOP or time shift finish before taking the bus
+  // (not needed when called from callback, engine is already running)
+  if (I2C_Bus_State != I2C_ASYNC_BUSY) {
+    i2cMaster_Wait_Ready();
+  }
+
+  uint8_t sreg = SREG;
+  cli();
+  uint8_t next = (Async_Tail + 1) & (FRAM_ASYNC_QUEUE_SIZE - 1);
+  if (next == Async_Head) {
+    SREG = sreg;
+    return 0;                     // Queue full
+  }
+
+  txn->status = FRAM_ASYNC_QUEUED;
+  txn->error = 0;
+  Async_Queue[Async_Tail] = txn;
+  Async_Tail = next;
+
+  if (I2C_Bus_State != I2C_ASYNC_BUSY) {
+    I2C_Bus_State = I2C_ASYNC_BUSY;
+    Async_Begin(0);
+  }
+  SREG = sreg;
+  return 1;
+}
+
+// Fill transaction with slave address and word address type of device
+void Async_Setup(FramDevice& dev, FramAsync_Txn* txn, uint8_t dir, uint16_t word_adr,
+                 uint8_t* data, uint16_t len, FramAsync_Callback callback)
+{
+  txn->sla_wr = FRAM_SLA(dev, word_adr);
+  txn->adr_bytes = (dev.adr_type == 1) ? 2 : 1;
+  txn->word_adr = word_adr;
+  txn->buf = data;
+  txn->len = len;
+  txn->dir = dir;
+  txn->callback = callback;
+  FRAM_Latch_Set(dev, word_adr, 0);    // Interrupt moves address latch, forget it
+}
+
+bool FRAM_Async_Write(FramDevice& dev, FramAsync_Txn* txn, uint16_t word_adr, uint8_t* data,
+                      uint16_t len, FramAsync_Callback callback = 0)
+{
+  Async_Setup(dev, txn, FRAM_ASYNC_WRITE, word_adr, data, len, callback);
+  return FRAM_Async_Submit(txn);
+}
+
+bool FRAM_Async_Read(FramDevice& dev, FramAsync_Txn* txn, uint16_t word_adr, uint8_t* data,
+                     uint16_t len, FramAsync_Callback callback = 0)
+{
+  Async_Setup(dev, txn, FRAM_ASYNC_READ, word_adr, data, len, callback);
+  return FRAM_Async_Submit(txn);
+}
+
+// Without device, use current i2cMaster_Init() and FRAM_Word_Adr() settings
+bool FRAM_Async_Write(FramAsync_Txn* txn, uint16_t word_adr, uint8_t* data, uint16_t len,
+                      FramAsync_Callback callback = 0)
+{
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Async_Write(dev, txn, word_adr, data, len, callback);
+}
+
+bool FRAM_Async_Read(FramAsync_Txn* txn, uint16_t word_adr, uint8_t* data, uint16_t len,
+                     FramAsync_Callback callback = 0)
+{
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Async_Read(dev, txn, word_adr, data, len, callback);
+}
+
+uint8_t FRAM_Async_Status(FramAsync_Txn* txn)
+{
+  return txn->status;
+}
+
+bool FRAM_Async_Idle(void)
+{
+  return I2C_Bus_State != I2C_ASYNC_BUSY;
+}
+
+// Abort all queued transactions after TWI interrupt stopped responding
+void FRAM_Async_Abort(void)
+{
+  uint8_t sreg = SREG;
+  cli();
+  while (Async_Head != Async_Tail) {
+    FramAsync_Txn* txn = Async_Queue[Async_Head];
+    Async_Head = (Async_Head + 1) & (FRAM_ASYNC_QUEUE_SIZE - 1);
+    txn->error = ASYNC_dead_loop;
+    txn->twsr = TWSR & 0xF8;
+    txn->status = FRAM_ASYNC_ERROR;
+    I2C_TRACE_ERROR(ASYNC_dead_loop);
+    I2C_TRACE_TXN(0);
+  }
+  // Free bus from slave holding SDA, TWI enabled again (interrupt off)
+  if (i2cMaster_Bus_Recover()) {
+    I2C_Bus_State = I2C_READY;
+  }
+  else {
+    I2C_Recover_Sec = Ref_Sec;
+    I2C_Bus_State = I2C_RECOVERING;
+  }
+  SREG = sreg;
+}
+
+// Time one TWI interrupt may take to arrive: longest stage budget in byte
+// times (9 SCL clocks) at current bus speed, in micro seconds
+uint32_t FRAM_Async_Timeout_us(void)
+{
+  uint8_t bytes = 1;
+  for (uint8_t stage = 0; stage < I2C_STAGES; stage++) {
+    if (I2C_Timeout_Bytes[stage] > bytes) bytes = I2C_Timeout_Bytes[stage];
+  }
+  uint32_t scl_cycles = 16 + 2UL * I2C_TWBR * (1UL << (2 * I2C_TWPS));
+  return (9 * scl_cycles * bytes) / (F_CPU / 1000000UL) + 1;
+}
+
+// Wait until transaction is finished (txn = 0 waits whole queue)
+// Avoid while dead-loop by BREAKING when interrupt made no progress in
+// FRAM_Async_Timeout_us()
+uint8_t FRAM_Async_Wait(FramAsync_Txn* txn)
+{
+  uint8_t progress = Async_Progress;
+  uint8_t status = FRAM_ASYNC_DONE;
+  uint32_t budget = FRAM_Async_Timeout_us();
+  unsigned long since = micros();
+  while (txn ? (txn->status < FRAM_ASYNC_DONE) : (I2C_Bus_State == I2C_ASYNC_BUSY))
+  {
+    if (progress != Async_Progress) {
+      progress = Async_Progress;
+      since = micros();
+    }
+    else if (micros() - since > budget && progress == Async_Progress)
+    { // If wait condition exceeded, then break this while loop
+      // (progress checked again, interrupt with callback may have run meanwhile)
+      FRAM_Async_Abort();
+      status = FRAM_ASYNC_ERROR;
+      break;
+    }
+  }
+  return txn ? txn->status : status;
+}
+
+void FRAM_Async_Drain(void)
+{
+  FRAM_Async_Wait(0);
+}
+
+#endif
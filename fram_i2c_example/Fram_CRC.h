@@ -0,0 +1,224 @@
+/*
+    FRAM CRC During Transfer
+    ------------------------
+    Header file name - "Fram_CRC.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    CRC-16 and CRC-32 updated byte by byte inside the read/write data loops,
+    while the byte is shifting on the bus (between i2cMaster_Data_Write_Begin()
+    and i2cMaster_Data_Write_End(), same for reads). Checking stored data
+    needs no second read pass and almost no extra time.
+
+    Streaming, CRC is carried between calls:
+      uint16_t crc = FramCRC16::init;
+      FRAM_Write_Buffer_CRC<FramCRC16>(fram1, 0x100, part1, 64, crc);
+      FRAM_Write_Buffer_CRC<FramCRC16>(fram1, 0x140, part2, 64, crc);
+      crc = FramCRC16::Final(crc);
+
+    Checksummed blocks, data and CRC in one sequential transaction:
+      FRAM_Write_Block_CRC<FramCRC32>(fram1, 0x200, buf, 100);  // 104 bytes used
+      if (!FRAM_Read_Block_CRC<FramCRC32>(fram1, 0x200, buf, 100)) { ... }
+
+    CRC types:
+      FramCRC16 - CRC-16/CCITT-FALSE (poly 0x1021, init 0xFFFF), 2 bytes
+      FramCRC32 - CRC-32 (IEEE 802.3, as zlib), 4 bytes
+    Nibble tables (16 entries) are kept in flash (PROGMEM): 32 bytes for
+    CRC-16 and 64 bytes for CRC-32, two lookups per byte.
+
+    Device is a FramDevice or a FramChip ("Fram_Device_Traits.h"):
+      FRAM_Write_Block_CRC<FramCRC16>(Fram1(), 0x300, buf, 32);
+
+    NOTES: Stored CRC is little endian. Transfers run through the transfer
+           core (FRAM_Core_Write_Hook()/FRAM_Core_Read_Hook() in
+           "Fram_Rx_Tx_Operation.h"), page splitting of 8-bit word address
+           devices and address latch are the same as FRAM_Write_Buffer().
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_CRC_H
+#define FRAM_CRC_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+//**************** Nibble Tables ******************//
+const uint16_t FRAM_CRC16_Table[16] PROGMEM = {
+  0x0000, 0x1021, 0x2042, 0x3063, 0x4084, 0x50A5, 0x60C6, 0x70E7,
+  0x8108, 0x9129, 0xA14A, 0xB16B, 0xC18C, 0xD1AD, 0xE1CE, 0xF1EF
+};
+
+const uint32_t FRAM_CRC32_Table[16] PROGMEM = {
+  0x00000000, 0x1DB71064, 0x3B6E20C8, 0x26D930AC,
+  0x76DC4190, 0x6B6B51F4, 0x4DB26158, 0x5005713C,
+  0xEDB88320, 0xF00F9344, 0xD6D6A3E8, 0xCB61B38C,
+  0x9B64C2B0, 0x86D3D2D4, 0xA00AE278, 0xBDBDF21C
+};
+
+//**************** CRC Types ******************//
+struct FramCRC16 {
+  typedef uint16_t value_t;
+  static const uint16_t init = 0xFFFF;
+
+  // MSB first, high nibble then low nibble
+  static uint16_t Update(uint16_t crc, uint8_t data) {
+    crc = (crc << 4) ^ pgm_read_word(&FRAM_CRC16_Table[(crc >> 12) ^ (data >> 4)]);
+    crc = (crc << 4) ^ pgm_read_word(&FRAM_CRC16_Table[(crc >> 12) ^ (data & 0x0F)]);
+    return crc;
+  }
+
+  static uint16_t Final(uint16_t crc) {
+    return crc;
+  }
+};
+
+struct FramCRC32 {
+  typedef uint32_t value_t;
+  static const uint32_t init = 0xFFFFFFFF;
+
+  // Reflected, low nibble first
+  static uint32_t Update(uint32_t crc, uint8_t data) {
+    crc = (crc >> 4) ^ pgm_read_dword(&FRAM_CRC32_Table[(crc ^ data) & 0x0F]);
+    crc = (crc >> 4) ^ pgm_read_dword(&FRAM_CRC32_Table[(crc ^ (data >> 4)) & 0x0F]);
+    return crc;
+  }
+
+  static uint32_t Final(uint32_t crc) {
+    return ~crc;
+  }
+};
+
+// CRC of RAM buffer, e.g. to compare with a stored one
+template <class C>
+typename C::value_t FRAM_CRC(const void* data, uint16_t len) {
+  const uint8_t* buf = (const uint8_t*)data;
+  typename C::value_t crc = C::init;
+  for (uint16_t i = 0; i < len; i++) {
+    crc = C::Update(crc, buf[i]);
+  }
+  return C::Final(crc);
+}
+
+//**************** Transfer Hooks ******************//
+// Called by FRAM_Core_Write_Hook()/FRAM_Core_Read_Hook() for each byte,
+// page splitting and device select are done by the transfer core.
+
+// Write len bytes of buf, CRC of data is updated while each byte is on
+// the bus, then the bytes of tail (C::Final(crc), little endian) if any
+template <class C>
+struct FramCRC_Write_Hook {
+  const uint8_t* buf;
+  uint16_t len;
+  typename C::value_t& crc;
+  typename C::value_t tail;
+
+  uint8_t Next(uint16_t k) {
+    if (k < len) return buf[k];
+    if (k == len) tail = C::Final(crc);
+    return (uint8_t)(tail >> (8 * (k - len)));    // Little endian
+  }
+
+  void Sent(uint16_t k, uint8_t data) {
+    if (k < len) crc = C::Update(crc, data);      // While byte is shifting
+  }
+};
+
+// Read len bytes into buf, then tail bytes (stored CRC), CRC of each byte
+// is updated while next one is on the bus
+template <class C>
+struct FramCRC_Read_Hook {
+  uint8_t* buf;
+  uint16_t len;
+  typename C::value_t& crc;
+  uint8_t* tail;
+
+  void Shifting(uint16_t k) {
+    if (k > 0 && k <= len) crc = C::Update(crc, buf[k - 1]);   // Previous byte
+  }
+
+  void Received(uint16_t k, uint8_t data) {
+    if (k < len) buf[k] = data;
+    else tail[k - len] = data;
+  }
+};
+
+// D is a transfer core device: FRAM_Traits(dev) or a FramChip
+// append = 1: C::Final(crc) follows data in the same transaction
+template <class C, class D>
+bool FRAM_CRC_Write(const D& d, uint16_t word_adr, const uint8_t* buf, uint16_t len,
+                    typename C::value_t& crc, bool append) {
+  FramCRC_Write_Hook<C> h = {buf, len, crc, 0};
+  return FRAM_Core_Write_Hook(d, word_adr, len + (append ? sizeof(crc) : 0), h);
+}
+
+template <class C, class D>
+bool FRAM_CRC_Read(const D& d, uint16_t word_adr, uint8_t* buf, uint16_t len,
+                   typename C::value_t& crc, uint8_t* tail, uint8_t tail_len) {
+  FramCRC_Read_Hook<C> h = {buf, len, crc, tail};
+  bool ok = FRAM_Core_Read_Hook(d, word_adr, len + tail_len, h);
+  if (ok && tail_len == 0 && len > 0) {
+    crc = C::Update(crc, buf[len - 1]);     // No tail, last byte not counted yet
+  }
+  return ok;
+}
+
+//**************** Streaming ******************//
+// Start with crc = C::init, take C::Final(crc) after last part
+template <class C, class D>
+bool FRAM_Write_Buffer_CRC(const D& d, uint16_t word_adr, const void* data, uint16_t len,
+                           typename C::value_t& crc) {
+  return FRAM_CRC_Write<C>(d, word_adr, (const uint8_t*)data, len, crc, 0);
+}
+
+template <class C, class D>
+bool FRAM_Read_Buffer_CRC(const D& d, uint16_t word_adr, void* data, uint16_t len,
+                          typename C::value_t& crc) {
+  return FRAM_CRC_Read<C>(d, word_adr, (uint8_t*)data, len, crc, 0, 0);
+}
+
+template <class C>
+bool FRAM_Write_Buffer_CRC(FramDevice& dev, uint16_t word_adr, const void* data, uint16_t len,
+                           typename C::value_t& crc) {
+  return FRAM_Write_Buffer_CRC<C>(FRAM_Traits(dev), word_adr, data, len, crc);
+}
+
+template <class C>
+bool FRAM_Read_Buffer_CRC(FramDevice& dev, uint16_t word_adr, void* data, uint16_t len,
+                          typename C::value_t& crc) {
+  return FRAM_Read_Buffer_CRC<C>(FRAM_Traits(dev), word_adr, data, len, crc);
+}
+
+//**************** Checksummed Blocks ******************//
+// Data followed by its CRC, len + sizeof(C::value_t) bytes of FRAM
+template <class C, class D>
+bool FRAM_Write_Block_CRC(const D& d, uint16_t word_adr, const void* data, uint16_t len) {
+  typename C::value_t crc = C::init;
+  return FRAM_CRC_Write<C>(d, word_adr, (const uint8_t*)data, len, crc, 1);
+}
+
+// Returns 0 if transfer failed or stored CRC does not match
+template <class C, class D>
+bool FRAM_Read_Block_CRC(const D& d, uint16_t word_adr, void* data, uint16_t len) {
+  typename C::value_t crc = C::init;
+  uint8_t tail[sizeof(crc)];
+  if (!FRAM_CRC_Read<C>(d, word_adr, (uint8_t*)data, len, crc, tail, sizeof(tail))) return 0;
+
+  typename C::value_t stored = 0;
+  for (uint8_t i = 0; i < sizeof(stored); i++) {
+    stored |= (typename C::value_t)tail[i] << (8 * i);
+  }
+  return C::Final(crc) == stored;
+}
+
+template <class C>
+bool FRAM_Write_Block_CRC(FramDevice& dev, uint16_t word_adr, const void* data, uint16_t len) {
+  return FRAM_Write_Block_CRC<C>(FRAM_Traits(dev), word_adr, data, len);
+}
+
+template <class C>
+bool FRAM_Read_Block_CRC(FramDevice& dev, uint16_t word_adr, void* data, uint16_t len) {
+  return FRAM_Read_Block_CRC<C>(FRAM_Traits(dev), word_adr, data, len);
+}
+
+#endif
@@ -0,0 +1,176 @@
+/*
+    FRAM Write-Back Line Cache
+    --------------------------
+    Header file name - "Fram_Cache.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Small set-associative cache in RAM above FRAM read/write functions.
+    FRAM is divided into lines of FRAM_CACHE_LINE bytes. A line is kept in
+    one of FRAM_CACHE_WAYS slots of its set, the least recently used slot is
+    replaced on miss.
+      - Read hit : byte is served from RAM, no bus access
+      - Write hit: byte is changed in RAM, line is marked dirty
+      - Miss     : dirty victim line is written back, line is read from FRAM
+                   in one sequential transaction
+    Dirty lines are written to FRAM on replacement or FRAM_Cache_Flush().
+
+    RAM usage: FRAM_CACHE_SETS * FRAM_CACHE_WAYS * (FRAM_CACHE_LINE + 13)
+               bytes, 232 bytes with default settings.
+    Define FRAM_CACHE_LINE/SETS/WAYS before including this header to change
+    them (LINE and SETS must be power of 2).
+
+    NOTES: Cached bytes are not in FRAM until flushed. Call FRAM_Cache_Flush()
+           before power down, before i2cMaster_Disable() and before using
+           FRAM_Read()/FRAM_Write() on cached addresses.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_CACHE_H
+#define FRAM_CACHE_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_CACHE_LINE
+#define FRAM_CACHE_LINE     16      // Bytes per line
+#endif
+#ifndef FRAM_CACHE_SETS
+#define FRAM_CACHE_SETS     4       // Sets
+#endif
+#ifndef FRAM_CACHE_WAYS
+#define FRAM_CACHE_WAYS     2       // Lines per set
+#endif
+
+struct FramCacheLine {
+  FramDevice dev;                   // Device of line
+  uint16_t adr;                     // Word address of first byte
+  bool valid;                       // Line holds FRAM data
+  bool dirty;                       // Line changed since read from FRAM
+  uint8_t age;                      // 0 = most recently used in set
+  uint8_t data[FRAM_CACHE_LINE];
+};
+
+FramCacheLine Cache_Line[FRAM_CACHE_SETS][FRAM_CACHE_WAYS];
+
+// Statistics
+unsigned long Cache_Hits = 0;       // Accesses served from RAM
+unsigned long Cache_Misses = 0;     // Lines read from FRAM
+unsigned long Cache_Writebacks = 0; // Dirty lines written to FRAM
+unsigned long Cache_Errors = 0;     // Failed write backs, line kept dirty
+
+
+// Write dirty line back to FRAM
+bool FRAM_Cache_Clean(FramCacheLine& line) {
+  if (!line.valid || !line.dirty) return 1;
+
+  if (!FRAM_Write_Buffer(line.dev, line.adr, line.data, FRAM_CACHE_LINE)) {
+    Cache_Errors++;                 // Line stays dirty, written again on next clean
+    return 0;
+  }
+  line.dirty = 0;
+  Cache_Writebacks++;
+  return 1;
+}
+
+// Write all dirty lines back to FRAM, lines stay cached
+bool FRAM_Cache_Flush(void) {
+  bool ok = 1;
+  for (uint8_t s = 0; s < FRAM_CACHE_SETS; s++) {
+    for (uint8_t w = 0; w < FRAM_CACHE_WAYS; w++) {
+      ok &= FRAM_Cache_Clean(Cache_Line[s][w]);
+    }
+  }
+  return ok;
+}
+
+// Flush and drop all lines, next access reads FRAM again
+bool FRAM_Cache_Invalidate(void) {
+  bool ok = FRAM_Cache_Flush();
+  for (uint8_t s = 0; s < FRAM_CACHE_SETS; s++) {
+    for (uint8_t w = 0; w < FRAM_CACHE_WAYS; w++) {
+      Cache_Line[s][w].valid = 0;
+    }
+  }
+  return ok;
+}
+
+// Mark way as most recently used in its set
+void FRAM_Cache_Touch(FramCacheLine* set, uint8_t way) {
+  for (uint8_t w = 0; w < FRAM_CACHE_WAYS; w++) {
+    if (w != way && set[w].age <= set[way].age) {
+      set[w].age++;
+    }
+  }
+  set[way].age = 0;
+}
+
+// Find line of word address, read it from FRAM on miss
+// Returns 0 if line cannot be read
+FramCacheLine* FRAM_Cache_Lookup(FramDevice& dev, uint16_t word_adr) {
+  uint16_t line_adr = word_adr & ~(FRAM_CACHE_LINE - 1);
+  FramCacheLine* set = Cache_Line[(word_adr / FRAM_CACHE_LINE) & (FRAM_CACHE_SETS - 1)];
+
+  // 1. Hit
+  for (uint8_t w = 0; w < FRAM_CACHE_WAYS; w++) {
+    if (set[w].valid && set[w].adr == line_adr && set[w].dev.sla_wr == dev.sla_wr) {
+      FRAM_Cache_Touch(set, w);
+      Cache_Hits++;
+      return &set[w];
+    }
+  }
+
+  // 2. Miss, replace invalid or least recently used line
+  uint8_t victim = 0;
+  for (uint8_t w = 0; w < FRAM_CACHE_WAYS; w++) {
+    if (!set[w].valid) {
+      victim = w;
+      break;
+    }
+    if (set[w].age > set[victim].age) {
+      victim = w;
+    }
+  }
+  FramCacheLine& line = set[victim];
+  if (!FRAM_Cache_Clean(line)) return 0;     // Keep dirty data if write back failed
+
+  // 3. Fill line from FRAM
+  Cache_Misses++;
+  line.dev = dev;
+  line.adr = line_adr;
+  line.dirty = 0;
+  line.valid = FRAM_Read_Buffer(dev, line_adr, line.data, FRAM_CACHE_LINE);
+  if (!line.valid) return 0;
+
+  FRAM_Cache_Touch(set, victim);
+  return &line;
+}
+
+char FRAM_Cache_Read(FramDevice& dev, uint16_t word_adr) {
+  FramCacheLine* line = FRAM_Cache_Lookup(dev, word_adr);
+  if (line == 0) return 0;
+  return line->data[word_adr & (FRAM_CACHE_LINE - 1)];
+}
+
+// Returns 0 if line cannot be read from FRAM (byte is not written)
+bool FRAM_Cache_Write(FramDevice& dev, uint16_t word_adr, uint8_t data) {
+  FramCacheLine* line = FRAM_Cache_Lookup(dev, word_adr);
+  if (line == 0) return 0;
+  line->data[word_adr & (FRAM_CACHE_LINE - 1)] = data;
+  line->dirty = 1;
+  return 1;
+}
+
+// Without device, use current i2cMaster_Init() and FRAM_Word_Adr() settings
+char FRAM_Cache_Read(uint16_t word_adr) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Cache_Read(dev, word_adr);
+}
+
+bool FRAM_Cache_Write(uint16_t word_adr, uint8_t data) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Cache_Write(dev, word_adr, data);
+}
+
+#endif
@@ -0,0 +1,166 @@
+/*
+    FRAM Compile-Time Device
+    ------------------------
+    Header file name - "Fram_Device_Traits.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Device type and slave address as template parameters. Word address
+    width, page bits and capacity are constants of the chip traits, so the
+    compiler removes the branches FramDevice checks at run time (e.g. no
+    high address byte code for FM24CL16B, no page splitting for MB85RC256V).
+      typedef FramChip<MB85RC256V, 0x50> Fram1;
+      Fram1::Write(0x10, 'A');
+      char c = Fram1::Read(0x10);
+      Fram1::Put(0x40, cfg);
+    Constant addresses are checked against capacity at compile time:
+      Fram1::Write<0x7FFF>('A');            // OK
+      Fram1::Write<0x8000>('A');            // static_assert fails
+      Fram1::Put<0x7FFE>(value_uint32);     // static_assert fails
+
+    Chip traits: FM24CL04B, FM24CL16B, MB85RC64, MB85RC256V. Other chips are added as
+    struct with adr_type, page_mask and capacity.
+
+    Transfers run through the same templates as FramDevice functions
+    (FRAM_Core_... in "Fram_Rx_Tx_Operation.h"), with constant chip values.
+
+    NOTES: Same address latch as FramDevice functions is used, both can be
+           mixed on the same chip. Fram1::Device() gives a FramDevice for
+           add-on headers (cache, log, key-value store).
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_DEVICE_TRAITS_H
+#define FRAM_DEVICE_TRAITS_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+//**************** Chip Traits ******************//
+struct FM24CL04B {
+  static const bool adr_type = 0;           // 8-bit word address
+  static const uint8_t page_mask = 0x01;    // A8 in slave address
+  static const uint32_t capacity = FM24CL04B_SIZE;
+};
+
+struct FM24CL16B {
+  static const bool adr_type = 0;           // 8-bit word address
+  static const uint8_t page_mask = 0x07;    // A8..A10 in slave address
+  static const uint32_t capacity = FM24CL16B_SIZE;
+};
+
+struct MB85RC64 {
+  static const bool adr_type = 1;           // 16-bit word address
+  static const uint8_t page_mask = 0x00;
+  static const uint32_t capacity = MB85RC64_SIZE;
+};
+
+struct MB85RC256V {
+  static const bool adr_type = 1;           // 16-bit word address
+  static const uint8_t page_mask = 0x00;
+  static const uint32_t capacity = MB85RC256V_SIZE;
+};
+
+//**************** Device ******************//
+template <class Chip, uint8_t SLA>
+struct FramChip {
+  static_assert(SLA < 0x80, "FramChip: slave address must be 7-bit");
+  static_assert(Chip::capacity <= 0x10000UL, "FramChip: capacity beyond 16-bit word address");
+  static_assert(Chip::adr_type == 1 || Chip::capacity <= FRAM_PAGE_SIZE * (Chip::page_mask + 1UL),
+                "FramChip: 8-bit word address chip needs page bits for its capacity");
+
+  // Chip values for the transfer core ("Fram_Rx_Tx_Operation.h"),
+  // FramChip is passed as its own traits, all of them are constants
+  static const uint8_t sla_wr = (uint8_t)((SLA & ~Chip::page_mask) << 1);
+
+  static uint8_t Base(void) {
+    return sla_wr;
+  }
+
+  static uint8_t SLA_Write(uint16_t word_adr) {
+    return sla_wr | (((word_adr >> 8) & Chip::page_mask) << 1);
+  }
+
+  static bool Adr_Type(void) {
+    return Chip::adr_type;
+  }
+
+  static uint32_t Capacity(void) {
+    return Chip::capacity;
+  }
+
+  static bool In_Range(uint16_t word_adr, uint16_t len) {
+    return (uint32_t)word_adr + len <= Chip::capacity;
+  }
+
+  // Bytes from word address which can be moved in one sequential transaction
+  static uint16_t Span(uint16_t word_adr, uint16_t len) {
+    if (Chip::page_mask == 0) return len;
+    uint16_t left = FRAM_PAGE_SIZE - (word_adr & (FRAM_PAGE_SIZE - 1));
+    return (len < left) ? len : left;
+  }
+
+  static bool Write(uint16_t word_adr, uint8_t data) {
+    if (!In_Range(word_adr, 1)) return 0;
+    return FRAM_Core_Write(FramChip(), word_adr, data);
+  }
+
+  static char Read(uint16_t word_adr) {
+    char data = 0;
+    FRAM_Core_Read_Buffer(FramChip(), word_adr, (uint8_t*)&data, 1);
+    return data;
+  }
+
+  static bool Write_Buffer(uint16_t word_adr, const void* data, uint16_t len) {
+    return FRAM_Core_Write_Buffer(FramChip(), word_adr, (const uint8_t*)data, len);
+  }
+
+  static bool Read_Buffer(uint16_t word_adr, void* data, uint16_t len) {
+    return FRAM_Core_Read_Buffer(FramChip(), word_adr, (uint8_t*)data, len);
+  }
+
+  template <typename T>
+  static bool Put(uint16_t word_adr, const T& value) {
+    static_assert(__is_trivially_copyable(T), "FramChip::Put: type must be trivially copyable");
+    return Write_Buffer(word_adr, &value, sizeof(T));
+  }
+
+  template <typename T>
+  static bool Get(uint16_t word_adr, T& value) {
+    static_assert(__is_trivially_copyable(T), "FramChip::Get: type must be trivially copyable");
+    return Read_Buffer(word_adr, &value, sizeof(T));
+  }
+
+  //**************** Constant Address ******************//
+  template <uint16_t ADR>
+  static bool Write(uint8_t data) {
+    static_assert(ADR < Chip::capacity, "FramChip::Write: address beyond capacity");
+    return Write(ADR, data);
+  }
+
+  template <uint16_t ADR>
+  static char Read(void) {
+    static_assert(ADR < Chip::capacity, "FramChip::Read: address beyond capacity");
+    return Read(ADR);
+  }
+
+  template <uint16_t ADR, typename T>
+  static bool Put(const T& value) {
+    static_assert(ADR + sizeof(T) <= Chip::capacity, "FramChip::Put: object beyond capacity");
+    return Put(ADR, value);
+  }
+
+  template <uint16_t ADR, typename T>
+  static bool Get(T& value) {
+    static_assert(ADR + sizeof(T) <= Chip::capacity, "FramChip::Get: object beyond capacity");
+    return Get(ADR, value);
+  }
+
+  // Run-time handle of same chip
+  static FramDevice Device(void) {
+    return FRAM_Device(SLA, Chip::adr_type, Chip::capacity);
+  }
+};
+
+#endif
@@ -0,0 +1,311 @@
+/*
+    FRAM Key-Value Store
+    --------------------
+    Header file name - "Fram_KV.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Persistent key-value store in a FRAM region with a hashed bucket table.
+    Keys are strings (up to FRAM_KV_MAX_KEY bytes) or 32-bit integers,
+    values are 0..255 bytes.
+
+    Region layout (from base word address):
+      +--------+---------------------------+---------------------------+
+      | header | bucket table (8 B/bucket) | data: key + value, ...    |
+      +--------+---------------------------+---------------------------+
+    A bucket holds key hash, key/value length, value capacity and word
+    address of key + value in data area. Collisions use linear probing.
+
+    Lookup cost (expected, table not too full):
+      1. read FRAM_KV_PROBE buckets from hash position in one sequential read
+      2. read key at data address and compare
+      3. read value, follows key at address latch, so only SLA+R is sent
+    Updating a value with same or smaller length rewrites it in place,
+    longer values are stored again at end of data area (old space is lost
+    until FRAM_KV_Format()).
+
+    NOTES: Keep bucket count about 1.5x the number of keys.
+           Header and buckets are stored in MCU byte order.
+           A bus error is not reported as missing key: get returns
+           FRAM_KV_ERROR, delete returns FRAM_KV_ERROR, put returns 0 and
+           does not store the key again in another bucket.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_KV_H
+#define FRAM_KV_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#define FRAM_KV_MAGIC       0x4B56  // "KV"
+#define FRAM_KV_PROBE       4       // Buckets read per probe transaction
+#define FRAM_KV_MAX_KEY     32      // Max. string key length
+#define FRAM_KV_INT_KEY     0x80    // Key length flag for integer keys
+#define FRAM_KV_ZERO_CHUNK  16      // Bytes per write while formatting
+
+// Lookup results
+#define FRAM_KV_NOT_FOUND   -1      // Key is not stored
+#define FRAM_KV_ERROR       -2      // Bus error, key may be stored
+
+// Bucket hash values
+#define FRAM_KV_EMPTY       0x0000  // Never used, ends probing
+#define FRAM_KV_DELETED     0xFFFF  // Deleted, probing continues
+
+struct __attribute__((packed)) FramKVHeader {
+  uint16_t magic;
+  uint16_t buckets;
+  uint16_t heap;                    // Used bytes of data area
+  uint16_t check;
+};
+
+struct __attribute__((packed)) FramKVEntry {
+  uint16_t hash;                    // Key hash, or FRAM_KV_EMPTY/DELETED
+  uint16_t adr;                     // Word address of key, value follows
+  uint8_t key_len;                  // Key length, FRAM_KV_INT_KEY set for integer key
+  uint8_t val_len;                  // Value length
+  uint8_t cap;                      // Value space reserved in data area
+  uint8_t reserved;
+};
+
+struct FramKV {
+  FramDevice dev;                   // Device of store region
+  uint16_t base;                    // Word address of region
+  uint16_t size;                    // Bytes of region
+  uint16_t buckets;                 // Buckets in table
+  uint16_t heap;                    // Used bytes of data area
+};
+
+
+uint16_t FRAM_KV_Hash(const uint8_t* key, uint8_t key_len) {
+  // FNV-1a over length and key bytes, folded to 16 bits
+  uint32_t h = 2166136261UL;
+  h = (h ^ key_len) * 16777619UL;
+  for (uint8_t i = 0; i < (key_len & ~FRAM_KV_INT_KEY); i++) {
+    h = (h ^ key[i]) * 16777619UL;
+  }
+  uint16_t hash = (uint16_t)(h ^ (h >> 16));
+  if (hash == FRAM_KV_EMPTY) hash = 1;
+  if (hash == FRAM_KV_DELETED) hash = FRAM_KV_DELETED - 1;
+  return hash;
+}
+
+uint16_t FRAM_KV_Check(FramKVHeader& hdr) {
+  return (uint16_t)(hdr.magic ^ (hdr.buckets * 31) ^ (hdr.heap * 131) ^ 0x5AA5);
+}
+
+uint16_t FRAM_KV_Entry_Adr(FramKV& kv, uint16_t index) {
+  return kv.base + sizeof(FramKVHeader) + index * sizeof(FramKVEntry);
+}
+
+uint16_t FRAM_KV_Data_Adr(FramKV& kv) {
+  return FRAM_KV_Entry_Adr(kv, kv.buckets);
+}
+
+// Bytes left in data area
+uint16_t FRAM_KV_Free(FramKV& kv) {
+  return kv.size - (FRAM_KV_Data_Adr(kv) - kv.base) - kv.heap;
+}
+
+bool FRAM_KV_Save_Header(FramKV& kv) {
+  FramKVHeader hdr;
+  hdr.magic = FRAM_KV_MAGIC;
+  hdr.buckets = kv.buckets;
+  hdr.heap = kv.heap;
+  hdr.check = FRAM_KV_Check(hdr);
+  return FRAM_Put(kv.dev, kv.base, hdr);
+}
+
+// Empty store, all buckets are cleared
+bool FRAM_KV_Format(FramKV& kv) {
+  uint8_t zero[FRAM_KV_ZERO_CHUNK];
+  memset(zero, 0, sizeof(zero));
+
+  uint16_t adr = FRAM_KV_Entry_Adr(kv, 0);
+  uint16_t left = kv.buckets * sizeof(FramKVEntry);
+  while (left > 0) {
+    uint16_t n = (left < sizeof(zero)) ? left : sizeof(zero);
+    if (!FRAM_Write_Buffer(kv.dev, adr, zero, n)) return 0;
+    adr += n;
+    left -= n;
+  }
+
+  kv.heap = 0;
+  return FRAM_KV_Save_Header(kv);
+}
+
+// Open store region
+// Returns 1 if existing store is found, 0 if region is formatted as new store
+// (or cannot be used, then kv.buckets = 0)
+bool FRAM_KV_Begin(FramKV& kv, FramDevice& dev, uint16_t base, uint16_t size, uint16_t buckets) {
+  kv.dev = dev;
+  kv.base = base;
+  kv.size = size;
+  kv.buckets = buckets;
+  kv.heap = 0;
+  if (buckets == 0 || sizeof(FramKVHeader) + (uint32_t)buckets * sizeof(FramKVEntry) > size) {
+    kv.buckets = 0;
+    return 0;
+  }
+
+  FramKVHeader hdr;
+  if (FRAM_Get(dev, base, hdr) && hdr.magic == FRAM_KV_MAGIC &&
+      hdr.check == FRAM_KV_Check(hdr) && hdr.buckets == buckets) {
+    kv.heap = hdr.heap;
+    if ((uint32_t)(FRAM_KV_Data_Adr(kv) - base) + kv.heap <= size) return 1;   // Heap inside region
+  }
+
+  FRAM_KV_Format(kv);
+  return 0;
+}
+
+// Compare key stored at entry with key
+// Returns 1 if same key, 0 if different, FRAM_KV_ERROR if key cannot be read
+int8_t FRAM_KV_Key_Match(FramKV& kv, FramKVEntry& e, const uint8_t* key, uint8_t key_len) {
+  uint8_t stored[FRAM_KV_MAX_KEY];
+  uint8_t n = key_len & ~FRAM_KV_INT_KEY;
+  if (!FRAM_Read_Buffer(kv.dev, e.adr, stored, n)) return FRAM_KV_ERROR;
+  return memcmp(stored, key, n) == 0;
+}
+
+// Find bucket of key
+// Returns bucket index, FRAM_KV_NOT_FOUND or FRAM_KV_ERROR (lookup aborted),
+// free_slot is first bucket where key can be inserted (-1 if table is full)
+int16_t FRAM_KV_Find(FramKV& kv, const uint8_t* key, uint8_t key_len, FramKVEntry& e, int16_t& free_slot) {
+  uint16_t hash = FRAM_KV_Hash(key, key_len);
+  uint16_t index = hash % kv.buckets;
+  free_slot = -1;
+
+  for (uint16_t n = 0; n < kv.buckets; ) {
+    // Read probe window in one transaction, not beyond end of table
+    FramKVEntry win[FRAM_KV_PROBE];
+    uint16_t count = FRAM_KV_PROBE;
+    if (count > kv.buckets - index) count = kv.buckets - index;
+    if (count > kv.buckets - n) count = kv.buckets - n;
+    if (!FRAM_Read_Buffer(kv.dev, FRAM_KV_Entry_Adr(kv, index), win, count * sizeof(FramKVEntry))) {
+      return FRAM_KV_ERROR;
+    }
+
+    for (uint8_t i = 0; i < count; i++) {
+      if (win[i].hash == FRAM_KV_EMPTY) {
+        if (free_slot < 0) free_slot = index + i;
+        return FRAM_KV_NOT_FOUND;
+      }
+      if (win[i].hash == FRAM_KV_DELETED) {
+        if (free_slot < 0) free_slot = index + i;
+        continue;
+      }
+      if (win[i].hash == hash && win[i].key_len == key_len) {
+        int8_t match = FRAM_KV_Key_Match(kv, win[i], key, key_len);
+        if (match == FRAM_KV_ERROR) return FRAM_KV_ERROR;
+        if (match) {
+          e = win[i];
+          return index + i;
+        }
+      }
+    }
+
+    n += count;
+    index += count;
+    if (index == kv.buckets) index = 0;
+  }
+  return FRAM_KV_NOT_FOUND;
+}
+
+// Returns value length (value is copied up to max bytes),
+// FRAM_KV_NOT_FOUND or FRAM_KV_ERROR
+int16_t FRAM_KV_Get_Key(FramKV& kv, const uint8_t* key, uint8_t key_len, void* val, uint8_t max) {
+  if (kv.buckets == 0) return FRAM_KV_NOT_FOUND;
+  FramKVEntry e;
+  int16_t free_slot;
+  int16_t index = FRAM_KV_Find(kv, key, key_len, e, free_slot);
+  if (index < 0) return index;
+
+  uint8_t n = (e.val_len < max) ? e.val_len : max;
+  if (!FRAM_Read_Buffer(kv.dev, e.adr + (key_len & ~FRAM_KV_INT_KEY), val, n)) return FRAM_KV_ERROR;
+  return e.val_len;
+}
+
+// Returns 0 if table or data area is full, or on bus error
+bool FRAM_KV_Put_Key(FramKV& kv, const uint8_t* key, uint8_t key_len, const void* val, uint8_t len) {
+  uint8_t klen = key_len & ~FRAM_KV_INT_KEY;
+  if (kv.buckets == 0 || klen > FRAM_KV_MAX_KEY) return 0;
+
+  FramKVEntry e;
+  int16_t free_slot;
+  int16_t index = FRAM_KV_Find(kv, key, key_len, e, free_slot);
+  if (index == FRAM_KV_ERROR) return 0;     // Key may be stored, don't add it twice
+
+  // 1. Existing key, value fits, rewrite in place
+  if (index >= 0 && len <= e.cap) {
+    if (!FRAM_Write_Buffer(kv.dev, e.adr + klen, val, len)) return 0;
+    e.val_len = len;
+    return FRAM_Put(kv.dev, FRAM_KV_Entry_Adr(kv, index), e);
+  }
+
+  // 2. New key or longer value, store key + value at end of data area
+  if (index < 0) {
+    if (free_slot < 0) return 0;
+    index = free_slot;
+  }
+  if ((uint16_t)(klen + len) > FRAM_KV_Free(kv)) return 0;
+
+  e.hash = FRAM_KV_Hash(key, key_len);
+  e.adr = FRAM_KV_Data_Adr(kv) + kv.heap;
+  e.key_len = key_len;
+  e.val_len = len;
+  e.cap = len;
+  e.reserved = 0;
+  if (!FRAM_Write_Buffer(kv.dev, e.adr, key, klen)) return 0;
+  if (!FRAM_Write_Buffer(kv.dev, e.adr + klen, val, len)) return 0;
+
+  kv.heap += klen + len;
+  if (!FRAM_KV_Save_Header(kv)) return 0;
+  return FRAM_Put(kv.dev, FRAM_KV_Entry_Adr(kv, index), e);
+}
+
+// Returns 1 if key is deleted, 0 if key is not found, FRAM_KV_ERROR on bus error
+int8_t FRAM_KV_Delete_Key(FramKV& kv, const uint8_t* key, uint8_t key_len) {
+  if (kv.buckets == 0) return 0;
+  FramKVEntry e;
+  int16_t free_slot;
+  int16_t index = FRAM_KV_Find(kv, key, key_len, e, free_slot);
+  if (index == FRAM_KV_ERROR) return FRAM_KV_ERROR;
+  if (index < 0) return 0;
+
+  uint16_t hash = FRAM_KV_DELETED;
+  if (!FRAM_Write_Buffer(kv.dev, FRAM_KV_Entry_Adr(kv, index), &hash, sizeof(hash))) return FRAM_KV_ERROR;
+  return 1;
+}
+
+//**************** String Keys ******************//
+int16_t FRAM_KV_Get(FramKV& kv, const char* key, void* val, uint8_t max) {
+  if (strlen(key) > FRAM_KV_MAX_KEY) return FRAM_KV_NOT_FOUND;
+  return FRAM_KV_Get_Key(kv, (const uint8_t*)key, strlen(key), val, max);
+}
+
+bool FRAM_KV_Put(FramKV& kv, const char* key, const void* val, uint8_t len) {
+  if (strlen(key) > FRAM_KV_MAX_KEY) return 0;
+  return FRAM_KV_Put_Key(kv, (const uint8_t*)key, strlen(key), val, len);
+}
+
+int8_t FRAM_KV_Delete(FramKV& kv, const char* key) {
+  if (strlen(key) > FRAM_KV_MAX_KEY) return 0;
+  return FRAM_KV_Delete_Key(kv, (const uint8_t*)key, strlen(key));
+}
+
+//**************** Integer Keys ******************//
+int16_t FRAM_KV_Get(FramKV& kv, uint32_t key, void* val, uint8_t max) {
+  return FRAM_KV_Get_Key(kv, (const uint8_t*)&key, sizeof(key) | FRAM_KV_INT_KEY, val, max);
+}
+
+bool FRAM_KV_Put(FramKV& kv, uint32_t key, const void* val, uint8_t len) {
+  return FRAM_KV_Put_Key(kv, (const uint8_t*)&key, sizeof(key) | FRAM_KV_INT_KEY, val, len);
+}
+
+int8_t FRAM_KV_Delete(FramKV& kv, uint32_t key) {
+  return FRAM_KV_Delete_Key(kv, (const uint8_t*)&key, sizeof(key) | FRAM_KV_INT_KEY);
+}
+
+#endif
@@ -0,0 +1,210 @@
+/*
+    FRAM Ring-Buffer Data Logger
+    ----------------------------
+    Header file name - "Fram_Log.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Circular log of fixed-size records in a FRAM region. When region is
+    full, oldest record is overwritten.
+
+    Region layout (from base word address):
+      +--------------+--------------+--------+--------+-----+
+      | head copy A  | head copy B  | slot 0 | slot 1 | ... |
+      +--------------+--------------+--------+--------+-----+
+      slot = record data (rec_len bytes) + sequence number (4 bytes)
+
+    Append:
+      1. Record and its sequence number are written in one sequential
+         write, sequence number last.
+      2. Head pointer (next sequence, next slot, record count) is saved
+         into copy A or B, alternating, so the other copy stays valid if
+         power fails while saving.
+    Boot recovery (FRAM_Log_Begin) reads both head copies, takes the valid
+    one with higher sequence and checks the one slot at head: if it already
+    holds the next sequence number, power failed between step 1 and 2 and
+    the record is taken over. No scanning of the region.
+
+    FRAM_Log_Format() clears the sequence number of every slot (one small
+    write per slot) before the head copies, so records of an old log are
+    never taken over by the new one.
+
+    NOTES: Record length is limited to FRAM_LOG_MAX_RECORD bytes.
+           Head copies are stored in MCU byte order.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_LOG_H
+#define FRAM_LOG_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_LOG_MAX_RECORD
+#define FRAM_LOG_MAX_RECORD 32      // Max. record length in bytes
+#endif
+#define FRAM_LOG_SEQ_SIZE   4       // Sequence number after each record
+#define FRAM_LOG_CHECK_INIT 0xA55A  // Head pointer check seed
+
+struct __attribute__((packed)) FramLogPtr {
+  uint32_t seq;                     // Sequence number of next record
+  uint16_t head;                    // Slot of next record
+  uint16_t count;                   // Records stored
+  uint16_t check;                   // Check value of fields above
+};
+
+struct FramLog {
+  FramDevice dev;                   // Device of log region
+  uint16_t base;                    // Word address of region
+  uint16_t slots;                   // Records fitting in region
+  uint8_t rec_len;                  // Record length without sequence number
+  uint32_t seq;                     // Sequence number of next record
+  uint16_t head;                    // Slot of next record
+  uint16_t count;                   // Records stored
+};
+
+
+uint16_t FRAM_Log_Check(FramLogPtr& ptr) {
+  uint16_t c = FRAM_LOG_CHECK_INIT;
+  uint16_t field[4] = {(uint16_t)ptr.seq, (uint16_t)(ptr.seq >> 16), ptr.head, ptr.count};
+  for (uint8_t i = 0; i < 4; i++) {
+    c = ((c << 3) | (c >> 13)) + field[i];   // Rotate and add
+  }
+  return c;
+}
+
+uint16_t FRAM_Log_Slot_Adr(FramLog& log, uint16_t slot) {
+  return log.base + 2 * sizeof(FramLogPtr) + slot * (uint16_t)(log.rec_len + FRAM_LOG_SEQ_SIZE);
+}
+
+// Save head pointer into copy A (0) or B (1)
+bool FRAM_Log_Save_Copy(FramLog& log, uint8_t copy) {
+  FramLogPtr ptr;
+  ptr.seq = log.seq;
+  ptr.head = log.head;
+  ptr.count = log.count;
+  ptr.check = FRAM_Log_Check(ptr);
+  uint16_t adr = log.base + copy * sizeof(FramLogPtr);
+  return FRAM_Put(log.dev, adr, ptr);
+}
+
+// Save head pointer, copy A for even and copy B for odd sequence numbers
+bool FRAM_Log_Save(FramLog& log) {
+  return FRAM_Log_Save_Copy(log, log.seq & 1);
+}
+
+// Empty log
+// 1. Sequence numbers of all slots are cleared, so an old record can not
+//    be taken over as power-fail record of the new log.
+// 2. Both head copies get the same pointer, recovery finds what is in RAM.
+bool FRAM_Log_Format(FramLog& log) {
+  bool ok = 1;
+  uint32_t blank = 0;               // 0 is never used, blank FRAM reads as 0
+  for (uint16_t slot = 0; slot < log.slots; slot++) {
+    ok &= FRAM_Put(log.dev, FRAM_Log_Slot_Adr(log, slot) + log.rec_len, blank);
+  }
+
+  log.seq = 1;
+  log.head = 0;
+  log.count = 0;
+  ok &= FRAM_Log_Save_Copy(log, 0);
+  ok &= FRAM_Log_Save_Copy(log, 1);
+  return ok;
+}
+
+// Advance head after record at head is written
+void FRAM_Log_Advance(FramLog& log) {
+  log.seq++;
+  log.head = (log.head + 1 == log.slots) ? 0 : log.head + 1;
+  if (log.count < log.slots) {
+    log.count++;
+  }
+}
+
+// Open log region and recover head pointer
+// Returns 1 if existing log is found, 0 if region is formatted as new log
+// (or cannot be used, then log.slots = 0)
+bool FRAM_Log_Begin(FramLog& log, FramDevice& dev, uint16_t base, uint16_t size, uint8_t rec_len) {
+  log.dev = dev;
+  log.base = base;
+  log.rec_len = rec_len;
+  log.slots = 0;
+  if (rec_len == 0 || rec_len > FRAM_LOG_MAX_RECORD || size < 2 * sizeof(FramLogPtr)) return 0;
+  log.slots = (size - 2 * sizeof(FramLogPtr)) / (rec_len + FRAM_LOG_SEQ_SIZE);
+  if (log.slots == 0) return 0;
+
+  // 1. Read both head copies in one transaction
+  FramLogPtr ptr[2];
+  if (!FRAM_Get(dev, base, ptr)) {
+    log.slots = 0;
+    return 0;
+  }
+
+  // 2. Take valid copy with higher sequence number
+  int8_t use = -1;
+  for (uint8_t i = 0; i < 2; i++) {
+    if (ptr[i].check != FRAM_Log_Check(ptr[i]) || ptr[i].seq == 0 ||
+        ptr[i].head >= log.slots || ptr[i].count > log.slots) continue;
+    if (use < 0 || (int32_t)(ptr[i].seq - ptr[use].seq) > 0) use = i;
+  }
+  if (use < 0) {
+    FRAM_Log_Format(log);
+    return 0;
+  }
+  log.seq = ptr[use].seq;
+  log.head = ptr[use].head;
+  log.count = ptr[use].count;
+
+  // 3. Take over record written before power failed
+  uint32_t seq = 0;
+  FRAM_Get(dev, FRAM_Log_Slot_Adr(log, log.head) + rec_len, seq);
+  if (seq == log.seq) {
+    FRAM_Log_Advance(log);
+    FRAM_Log_Save(log);
+  }
+  return 1;
+}
+
+// Append record of rec_len bytes
+bool FRAM_Log_Append(FramLog& log, const void* data) {
+  if (log.slots == 0) return 0;
+
+  // Record and sequence number in one sequential write
+  uint8_t rec[FRAM_LOG_MAX_RECORD + FRAM_LOG_SEQ_SIZE];
+  memcpy(rec, data, log.rec_len);
+  memcpy(rec + log.rec_len, &log.seq, FRAM_LOG_SEQ_SIZE);
+  if (!FRAM_Write_Buffer(log.dev, FRAM_Log_Slot_Adr(log, log.head), rec, log.rec_len + FRAM_LOG_SEQ_SIZE)) {
+    return 0;
+  }
+
+  FRAM_Log_Advance(log);
+  return FRAM_Log_Save(log);
+}
+
+uint16_t FRAM_Log_Count(FramLog& log) {
+  return log.count;
+}
+
+// Read record, index 0 = oldest, FRAM_Log_Count() - 1 = newest
+// Returns 0 if index is out of range or stored sequence number is wrong
+bool FRAM_Log_Read(FramLog& log, uint16_t index, void* data, uint32_t* seq = 0) {
+  if (index >= log.count) return 0;
+
+  uint16_t slot = (log.head + log.slots - log.count + index) % log.slots;
+  uint32_t expect = log.seq - log.count + index;
+
+  uint8_t rec[FRAM_LOG_MAX_RECORD + FRAM_LOG_SEQ_SIZE];
+  if (!FRAM_Read_Buffer(log.dev, FRAM_Log_Slot_Adr(log, slot), rec, log.rec_len + FRAM_LOG_SEQ_SIZE)) {
+    return 0;
+  }
+  uint32_t stored;
+  memcpy(&stored, rec + log.rec_len, FRAM_LOG_SEQ_SIZE);
+  if (stored != expect) return 0;
+
+  memcpy(data, rec, log.rec_len);
+  if (seq) *seq = stored;
+  return 1;
+}
+
+#endif
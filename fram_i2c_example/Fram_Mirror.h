@@ -0,0 +1,229 @@
+/*
+    FRAM Mirrored Pair
+    ------------------
+    Header file name - "Fram_Mirror.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    Region mirrored on two FRAM devices (RAID-1) for critical data, stored
+    as fixed-size blocks with a check value behind each block:
+      +---------------------+-------+---------------------+-------+-----
+      | block 0 (block_len) | check | block 1 (block_len) | check | ...
+      +---------------------+-------+---------------------+-------+-----
+    Same layout at same word address on both devices.
+
+      FramMirror m;
+      FRAM_Mirror_Begin(m, fram1, fram2, 0x6000, 1024, 16);
+      FRAM_Mirror_Write(m, 3, cfg);         // block 3 to both devices
+      FRAM_Mirror_Read(m, 3, cfg);          // from primary, one transaction
+
+    Write: primary first, then secondary.
+    Read : block and check from primary in one sequential read. If check
+           fails (power lost while writing, worn cell, device missing),
+           block is read from secondary and written back to primary.
+    Resync: compares both devices in bursts of FRAM_MIRROR_BURST bytes, one
+           read per device per burst. Blocks that differ are copied from the
+           valid side (primary if both are valid), one write per device per
+           burst. FRAM_Mirror_Resync_Step() does one burst per call so it can
+           run from loop() in background, FRAM_Mirror_Resync() does a full pass.
+
+    NOTES: Block length is limited to FRAM_MIRROR_BURST - 2 bytes.
+           Blocks never written have no valid copy, read returns 0.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_MIRROR_H
+#define FRAM_MIRROR_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_MIRROR_BURST
+#define FRAM_MIRROR_BURST   64      // Bytes compared per resync step (RAM x2)
+#endif
+#define FRAM_MIRROR_CHECK   2       // Check value bytes behind each block
+
+struct FramMirror {
+  FramDevice dev[2];
+  uint8_t primary;                  // Device serving reads (0 or 1)
+  uint16_t base;                    // Word address of region (both devices)
+  uint16_t blocks;                  // Blocks fitting in region
+  uint8_t block_len;                // Block length without check value
+  uint16_t resync_next;             // Next block of background resync
+
+  // Statistics
+  unsigned long fallbacks;          // Reads served by secondary
+  unsigned long repairs;            // Blocks copied to the other device
+};
+
+
+// Fletcher-16, seeded so blank (all 0x00) block is not valid
+uint16_t FRAM_Mirror_Check(const uint8_t* data, uint8_t len) {
+  uint16_t s1 = 0x5A, s2 = 0xA5;
+  for (uint8_t i = 0; i < len; i++) {
+    s1 = (s1 + data[i]) % 255;
+    s2 = (s2 + s1) % 255;
+  }
+  return (s2 << 8) | s1;
+}
+
+// Block followed by its check value
+bool FRAM_Mirror_Valid(FramMirror& m, const uint8_t* slot) {
+  uint16_t check;
+  memcpy(&check, slot + m.block_len, FRAM_MIRROR_CHECK);
+  return check == FRAM_Mirror_Check(slot, m.block_len);
+}
+
+uint8_t FRAM_Mirror_Slot_Len(FramMirror& m) {
+  return m.block_len + FRAM_MIRROR_CHECK;
+}
+
+uint16_t FRAM_Mirror_Adr(FramMirror& m, uint16_t block) {
+  return m.base + block * (uint16_t)FRAM_Mirror_Slot_Len(m);
+}
+
+// Returns 0 if block length does not fit in a burst (m.blocks = 0)
+bool FRAM_Mirror_Begin(FramMirror& m, FramDevice& primary, FramDevice& secondary,
+                       uint16_t base, uint16_t size, uint8_t block_len) {
+  m.dev[0] = primary;
+  m.dev[1] = secondary;
+  m.primary = 0;
+  m.base = base;
+  m.block_len = block_len;
+  m.blocks = 0;
+  m.resync_next = 0;
+  m.fallbacks = 0;
+  m.repairs = 0;
+  if (block_len == 0 || block_len > FRAM_MIRROR_BURST - FRAM_MIRROR_CHECK) return 0;
+
+  m.blocks = size / FRAM_Mirror_Slot_Len(m);
+  return m.blocks > 0;
+}
+
+// Swap devices, e.g. when primary is replaced
+void FRAM_Mirror_Set_Primary(FramMirror& m, uint8_t primary) {
+  m.primary = primary ? 1 : 0;
+}
+
+bool FRAM_Mirror_Write_Slot(FramMirror& m, uint8_t which, uint16_t block, const uint8_t* slot) {
+  return FRAM_Write_Buffer(m.dev[which], FRAM_Mirror_Adr(m, block), slot, FRAM_Mirror_Slot_Len(m));
+}
+
+// Write block of block_len bytes to both devices, primary first
+bool FRAM_Mirror_Write(FramMirror& m, uint16_t block, const void* data) {
+  if (block >= m.blocks) return 0;
+
+  uint8_t slot[FRAM_MIRROR_BURST];
+  memcpy(slot, data, m.block_len);
+  uint16_t check = FRAM_Mirror_Check(slot, m.block_len);
+  memcpy(slot + m.block_len, &check, FRAM_MIRROR_CHECK);
+
+  bool ok = FRAM_Mirror_Write_Slot(m, m.primary, block, slot);
+  ok &= FRAM_Mirror_Write_Slot(m, m.primary ^ 1, block, slot);
+  return ok;
+}
+
+// Read block from primary, from secondary if check fails
+// Returns 0 if neither device has a valid copy
+bool FRAM_Mirror_Read(FramMirror& m, uint16_t block, void* data) {
+  if (block >= m.blocks) return 0;
+
+  uint8_t slot[FRAM_MIRROR_BURST];
+  uint16_t adr = FRAM_Mirror_Adr(m, block);
+  uint8_t len = FRAM_Mirror_Slot_Len(m);
+
+  // 1. Fast path, one transaction on primary
+  if (FRAM_Read_Buffer(m.dev[m.primary], adr, slot, len) && FRAM_Mirror_Valid(m, slot)) {
+    memcpy(data, slot, m.block_len);
+    return 1;
+  }
+
+  // 2. Fallback to secondary and repair primary
+  if (!FRAM_Read_Buffer(m.dev[m.primary ^ 1], adr, slot, len) || !FRAM_Mirror_Valid(m, slot)) {
+    return 0;
+  }
+  m.fallbacks++;
+  if (FRAM_Mirror_Write_Slot(m, m.primary, block, slot)) {
+    m.repairs++;
+  }
+  memcpy(data, slot, m.block_len);
+  return 1;
+}
+
+// Typed block, type must fill block length
+template <typename T>
+bool FRAM_Mirror_Put(FramMirror& m, uint16_t block, const T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Mirror_Put: type must be trivially copyable");
+  if (sizeof(T) != m.block_len) return 0;
+  return FRAM_Mirror_Write(m, block, &value);
+}
+
+template <typename T>
+bool FRAM_Mirror_Get(FramMirror& m, uint16_t block, T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Mirror_Get: type must be trivially copyable");
+  if (sizeof(T) != m.block_len) return 0;
+  return FRAM_Mirror_Read(m, block, &value);
+}
+
+// Compare and repair one burst of blocks, starting at resync_next
+// Returns 1 when a full pass over the region is finished
+bool FRAM_Mirror_Resync_Step(FramMirror& m) {
+  if (m.blocks == 0) return 1;
+
+  uint8_t len = FRAM_Mirror_Slot_Len(m);
+  uint16_t first = m.resync_next;
+  uint16_t count = FRAM_MIRROR_BURST / len;
+  if (count > m.blocks - first) count = m.blocks - first;
+  uint16_t bytes = count * len;
+  uint16_t adr = FRAM_Mirror_Adr(m, first);
+
+  // 1. One burst read per device
+  uint8_t side[2][FRAM_MIRROR_BURST];
+  uint8_t p = m.primary, s = m.primary ^ 1;
+  bool read_p = FRAM_Read_Buffer(m.dev[p], adr, side[p], bytes);
+  bool read_s = FRAM_Read_Buffer(m.dev[s], adr, side[s], bytes);
+
+  // 2. Copy differing blocks in RAM from valid side
+  if (read_p && read_s && memcmp(side[p], side[s], bytes) != 0) {
+    bool dirty[2] = {0, 0};
+    for (uint16_t i = 0; i < count; i++) {
+      uint8_t* slot_p = side[p] + i * len;
+      uint8_t* slot_s = side[s] + i * len;
+      if (memcmp(slot_p, slot_s, len) == 0) continue;
+
+      if (FRAM_Mirror_Valid(m, slot_p)) {
+        memcpy(slot_s, slot_p, len);
+        dirty[s] = 1;
+        m.repairs++;
+      }
+      else if (FRAM_Mirror_Valid(m, slot_s)) {
+        memcpy(slot_p, slot_s, len);
+        dirty[p] = 1;
+        m.repairs++;
+      }
+    }
+
+    // 3. One burst write per repaired device
+    for (uint8_t d = 0; d < 2; d++) {
+      if (dirty[d]) FRAM_Write_Buffer(m.dev[d], adr, side[d], bytes);
+    }
+  }
+
+  m.resync_next = first + count;
+  if (m.resync_next >= m.blocks) {
+    m.resync_next = 0;
+    return 1;
+  }
+  return 0;
+}
+
+// Full pass, returns blocks repaired
+unsigned long FRAM_Mirror_Resync(FramMirror& m) {
+  unsigned long repairs = m.repairs;
+  m.resync_next = 0;
+  while (!FRAM_Mirror_Resync_Step(m)) {}
+  return m.repairs - repairs;
+}
+
+#endif
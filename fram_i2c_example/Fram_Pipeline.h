@@ -0,0 +1,207 @@
+/*
+    FRAM Double-Buffered Write Pipeline
+    -----------------------------------
+    Header file name - "Fram_Pipeline.h"
+    Must include: "Fram_Async_TWI.h"
+                  (already included "Fram_Rx_Tx_Operation.h")
+
+    Description:
+    Producer/consumer pipeline for sampling code. Application fills one RAM
+    buffer while the other one is written to FRAM by the TWI interrupt
+    (async engine), so sampling does not wait for the bus:
+      FramPipe pipe;
+      FRAM_Pipe_Begin(pipe, fram1, 0x6000, 0x1000);
+      if (!FRAM_Pipe_Write(pipe, sample)) { ... }   // both buffers full
+      FRAM_Pipe_Sync(pipe);                          // before power down
+    When a buffer is full it is handed to the interrupt and filling goes on
+    in the other one. If that one is still draining, the full buffer waits
+    and is started from the completion interrupt of the other one.
+
+    Backpressure: FRAM_Pipe_Write() returns 0 (byte not taken) when both
+    buffers are full, FRAM_Pipe_Ready() tells it before writing. Sampling
+    faster than the bus can drain shows up as Pipe stalls, not as lost bytes
+    in FRAM.
+
+    Region is used as a ring, writing goes on at region base after its end.
+    Buffers are handed over early at region end, so no transfer crosses it.
+
+    NOTES: Bytes are in FRAM only after their buffer is drained, call
+           FRAM_Pipe_Flush() to hand over a partly filled buffer and
+           FRAM_Pipe_Sync() to wait until everything is written.
+           FramPipe must stay valid while buffers are draining.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_PIPELINE_H
+#define FRAM_PIPELINE_H
+
+#include "Fram_Async_TWI.h"
+
+#ifndef FRAM_PIPE_BUFFER
+#define FRAM_PIPE_BUFFER    32      // Bytes per buffer
+#endif
+
+struct FramPipe;
+
+// Transaction first, completion interrupt finds its pipe from it
+struct FramPipeSlot {
+  FramAsync_Txn txn;
+  FramPipe* pipe;
+  uint16_t adr;                     // Word address of buffer
+  uint8_t len;                      // Bytes handed over
+  volatile bool pending;            // Full, waiting for other buffer to drain
+  uint8_t buf[FRAM_PIPE_BUFFER];
+};
+
+struct FramPipe {
+  FramDevice dev;
+  uint16_t base;                    // Word address of region
+  uint16_t size;                    // Bytes of region
+  uint16_t next;                    // Region offset of buffer being filled
+  uint8_t fill;                     // Buffer being filled (0 or 1)
+  uint8_t count;                    // Bytes in buffer being filled
+  FramPipeSlot slot[2];
+
+  // Statistics
+  unsigned long bytes;              // Bytes taken
+  unsigned long stalls;             // Bytes refused, both buffers full
+  volatile unsigned long errors;    // Buffers not written (bus error)
+};
+
+
+// Buffer is owned by interrupt (waiting or draining)
+bool FRAM_Pipe_Busy(FramPipeSlot& slot) {
+  return slot.pending || slot.txn.status < FRAM_ASYNC_DONE;
+}
+
+void FRAM_Pipe_Done(FramAsync_Txn* txn);
+
+// Start writing buffer, stays pending if async queue is full
+void FRAM_Pipe_Submit(FramPipeSlot& slot) {
+  if (!FRAM_Async_Write(slot.pipe->dev, &slot.txn, slot.adr, slot.buf, slot.len, FRAM_Pipe_Done)) {
+    slot.pending = 1;
+  }
+}
+
+// Completion interrupt: count errors and start the waiting buffer
+void FRAM_Pipe_Done(FramAsync_Txn* txn) {
+  FramPipeSlot* slot = (FramPipeSlot*)txn;
+  FramPipe* pipe = slot->pipe;
+  if (txn->status == FRAM_ASYNC_ERROR) {
+    pipe->errors++;
+  }
+
+  FramPipeSlot& other = pipe->slot[(slot == &pipe->slot[0]) ? 1 : 0];
+  if (other.pending) {
+    other.pending = 0;
+    FRAM_Pipe_Submit(other);
+  }
+}
+
+// Start waiting buffer whose other buffer is drained
+// (needed when async queue was full or transfers were aborted)
+void FRAM_Pipe_Poll(FramPipe& pipe) {
+  for (uint8_t b = 0; b < 2; b++) {
+    uint8_t sreg = SREG;
+    cli();
+    bool go = pipe.slot[b].pending && pipe.slot[b ^ 1].txn.status >= FRAM_ASYNC_DONE;
+    if (go) pipe.slot[b].pending = 0;
+    SREG = sreg;
+    if (go) FRAM_Pipe_Submit(pipe.slot[b]);
+  }
+}
+
+// Hand buffer being filled to interrupt, filling goes on in other buffer
+void FRAM_Pipe_Hand_Over(FramPipe& pipe) {
+  FramPipeSlot& slot = pipe.slot[pipe.fill];
+  slot.adr = pipe.base + pipe.next;
+  slot.len = pipe.count;
+  pipe.next += pipe.count;
+  if (pipe.next >= pipe.size) pipe.next = 0;    // Ring, go on at region base
+  pipe.count = 0;
+
+  // Other buffer still draining: wait for its completion interrupt
+  uint8_t sreg = SREG;
+  cli();
+  bool go = !FRAM_Pipe_Busy(pipe.slot[pipe.fill ^ 1]);
+  slot.pending = !go;
+  SREG = sreg;
+  if (go) FRAM_Pipe_Submit(slot);
+
+  pipe.fill ^= 1;
+}
+
+void FRAM_Pipe_Begin(FramPipe& pipe, FramDevice& dev, uint16_t base, uint16_t size) {
+  pipe.dev = dev;
+  pipe.base = base;
+  pipe.size = size;
+  pipe.next = 0;
+  pipe.fill = 0;
+  pipe.count = 0;
+  for (uint8_t b = 0; b < 2; b++) {
+    pipe.slot[b].pipe = &pipe;
+    pipe.slot[b].pending = 0;
+    pipe.slot[b].txn.status = FRAM_ASYNC_DONE;
+  }
+  pipe.bytes = 0;
+  pipe.stalls = 0;
+  pipe.errors = 0;
+}
+
+// Buffer being filled can take a byte
+bool FRAM_Pipe_Ready(FramPipe& pipe) {
+  FRAM_Pipe_Poll(pipe);
+  return !FRAM_Pipe_Busy(pipe.slot[pipe.fill]);
+}
+
+// Returns 0 if both buffers are full (backpressure), byte is not taken
+bool FRAM_Pipe_Write(FramPipe& pipe, uint8_t data) {
+  if (pipe.size == 0) return 0;
+  if (FRAM_Pipe_Busy(pipe.slot[pipe.fill]) && !FRAM_Pipe_Ready(pipe)) {
+    pipe.stalls++;
+    return 0;
+  }
+
+  pipe.slot[pipe.fill].buf[pipe.count++] = data;
+  pipe.bytes++;
+
+  // Full, or at region end
+  if (pipe.count == FRAM_PIPE_BUFFER || pipe.next + pipe.count >= pipe.size) {
+    FRAM_Pipe_Hand_Over(pipe);
+  }
+  return 1;
+}
+
+// Returns bytes taken, less than len if both buffers became full
+uint16_t FRAM_Pipe_Write(FramPipe& pipe, const void* data, uint16_t len) {
+  const uint8_t* buf = (const uint8_t*)data;
+  uint16_t n = 0;
+  while (n < len && FRAM_Pipe_Write(pipe, buf[n])) {
+    n++;
+  }
+  return n;
+}
+
+// Hand over partly filled buffer, returns 0 if it cannot be taken yet
+bool FRAM_Pipe_Flush(FramPipe& pipe) {
+  if (pipe.count == 0) return 1;
+  if (FRAM_Pipe_Busy(pipe.slot[pipe.fill])) return 0;
+  FRAM_Pipe_Hand_Over(pipe);
+  return 1;
+}
+
+// Wait until all taken bytes are written to FRAM
+// Returns 0 if a buffer could not be written
+bool FRAM_Pipe_Sync(FramPipe& pipe) {
+  unsigned long errors = pipe.errors;
+  while (!FRAM_Pipe_Flush(pipe) || FRAM_Pipe_Busy(pipe.slot[0]) || FRAM_Pipe_Busy(pipe.slot[1])) {
+    FRAM_Pipe_Poll(pipe);
+    if (FRAM_Async_Wait(0) == FRAM_ASYNC_ERROR) {
+      pipe.errors++;                // Aborted, no completion interrupt
+    }
+  }
+  return pipe.errors == errors;
+}
+
+#endif
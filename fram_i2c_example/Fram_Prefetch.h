@@ -0,0 +1,101 @@
+/*
+    FRAM Sequential Read-Ahead
+    --------------------------
+    Header file name - "Fram_Prefetch.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    FRAM_Read_Ahead(adr) reads single bytes like FRAM_Read(adr), but detects
+    sequential access. When a byte follows the previously read one, next
+    FRAM_PREFETCH_SIZE bytes are fetched with one sequential read and
+    following calls are served from RAM:
+      FRAM_Read_Ahead(0x10)   -> single read (not sequential yet)
+      FRAM_Read_Ahead(0x11)   -> burst read of 0x11..0x30
+      FRAM_Read_Ahead(0x12)   -> from RAM
+      ...
+    Random access keeps using single reads, so no bus time is wasted on
+    bytes which are never used.
+
+    NOTES: Buffer is not updated by writes. Call FRAM_Prefetch_Invalidate()
+           after writing to FRAM addresses which are read ahead.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_PREFETCH_H
+#define FRAM_PREFETCH_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_PREFETCH_SIZE
+#define FRAM_PREFETCH_SIZE  32      // Bytes fetched per burst
+#endif
+
+uint8_t Prefetch_Buf[FRAM_PREFETCH_SIZE];
+uint8_t Prefetch_Count = 0;         // Valid bytes in buffer
+uint16_t Prefetch_Adr = 0;          // Word address of first buffered byte
+uint16_t Prefetch_Last = 0;         // Word address of last byte read
+uint8_t Prefetch_Sla = 0;           // Slave address of buffer and last read, 0 = none
+
+// Statistics
+unsigned long Prefetch_Hits = 0;    // Reads served from RAM
+unsigned long Prefetch_Misses = 0;  // Reads which needed the bus
+unsigned long Prefetch_Bursts = 0;  // Read-ahead transactions
+
+
+// Percentage of reads served from RAM
+uint8_t FRAM_Prefetch_Hit_Rate(void) {
+  unsigned long total = Prefetch_Hits + Prefetch_Misses;
+  if (total == 0) return 0;
+  return (uint8_t)((Prefetch_Hits * 100UL) / total);
+}
+
+// Drop buffered bytes, next read goes to FRAM
+void FRAM_Prefetch_Invalidate(void) {
+  Prefetch_Count = 0;
+  Prefetch_Sla = 0;
+}
+
+char FRAM_Read_Ahead(FramDevice& dev, uint16_t word_adr) {
+  // 1. Hit, byte is in buffer
+  if (Prefetch_Count > 0 && Prefetch_Sla == dev.sla_wr &&
+      (uint16_t)(word_adr - Prefetch_Adr) < Prefetch_Count) {
+    Prefetch_Hits++;
+    Prefetch_Last = word_adr;
+    return Prefetch_Buf[word_adr - Prefetch_Adr];
+  }
+
+  Prefetch_Misses++;
+  bool sequential = (Prefetch_Sla == dev.sla_wr && word_adr == (uint16_t)(Prefetch_Last + 1));
+  Prefetch_Sla = dev.sla_wr;
+  Prefetch_Last = word_adr;
+  Prefetch_Count = 0;
+
+  // 2. Random access, single read
+  if (!sequential) {
+    return FRAM_Read(dev, word_adr);
+  }
+
+  // 3. Sequential access, burst read not beyond end of device
+  uint16_t len = FRAM_PREFETCH_SIZE;
+  if (dev.capacity != 0 && word_adr + (uint32_t)len > dev.capacity) {
+    if (word_adr >= dev.capacity) return 0;
+    len = dev.capacity - word_adr;
+  }
+  Prefetch_Bursts++;
+  if (!FRAM_Read_Buffer(dev, word_adr, Prefetch_Buf, len)) {
+    return 0;
+  }
+  Prefetch_Adr = word_adr;
+  Prefetch_Count = len;
+  return Prefetch_Buf[0];
+}
+
+// Without device, use current i2cMaster_Init() and FRAM_Word_Adr() settings
+char FRAM_Read_Ahead(uint16_t word_adr) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Read_Ahead(dev, word_adr);
+}
+
+#endif
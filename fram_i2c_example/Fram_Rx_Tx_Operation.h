@@ -7,12 +7,59 @@
 
     Description:
     This header file contains I2C read and write operation functions
-    To avoid duplicated operations, time shifting method applied to while loop
-    instead of using delay.
+    There is no fixed waiting before each operation. i2cMaster_Start() only
+    waits while previous STOP is transmitting, or time shift after a failed
+    transaction (see "Bus Ready Tracking" in "Master_TWI.h").
 
     UPDATED: Support 8-bit and 16-bit word addresses!
 
-    NOTES: FRAM_Word_Adr(n) is needed to declare word-address bits.
+    UPDATED: Binary-safe buffer read/write with 16-bit length!
+             FRAM_Write_Buffer(adr, data, len), FRAM_Read_Buffer(adr, data, len)
+             move any bytes (also '\0') up to 65535 bytes in one sequential
+             transaction. Returns 1 if transaction is finished without error.
+
+    UPDATED: Per-device handle!
+             FramDevice carries slave address, word address type and capacity.
+             All functions have an overload taking the device as first
+             argument, so several FRAMs (also different types) can be used
+             together without calling i2cMaster_Init() to switch between them.
+               i2cMaster_Bus_Init();                              // once
+               FramDevice fram1 = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+               FramDevice fram2 = FRAM_Device(0x54, 0, FM24CL04B_SIZE);
+               FRAM_Write(fram1, 0x10, 'A');
+               char c = FRAM_Read(fram2, 0x10);
+
+    UPDATED: Full 11-bit addressing for FM24CL16B!
+             With 8-bit word address, address bits above 8 are page bits in
+             slave address (FM24CL16B: A8..A10 -> slave address bits 0..2).
+             Bulk transfers are split at 256-byte page boundaries, one
+             sequential transaction per page.
+             Only for devices with capacity above 256 bytes, e.g.
+             FRAM_Device(0x50, 0, FM24CL16B_SIZE). Functions without device
+             argument use slave address of i2cMaster_Init() unchanged.
+
+    UPDATED: Current-address reads!
+             Driver tracks internal address latch of each chip (next address
+             after last access). If a read starts at latched address, word
+             address is not sent again: START + SLA+R only.
+             Streaming read cursor keeps one sequential read open:
+               FramCursor cur;
+               FRAM_Cursor_Open(cur, fram1, 0x0100);
+               while (...) c = FRAM_Cursor_Read(cur);
+               FRAM_Cursor_Close(cur);
+             Call FRAM_Latch_Invalidate() if chip is accessed by other code
+             or power cycled while sketch is running.
+
+    UPDATED: Typed read/write!
+             FRAM_Put(dev, adr, value) and FRAM_Get(dev, adr, value) move any
+             trivially copyable type (int, float, struct, array) with size
+             known at compile time, directly from/to the object:
+               Config cfg;
+               FRAM_Put(fram1, 0x40, cfg);
+               FRAM_Get(fram1, 0x40, cfg);
+
+    NOTES: FRAM_Word_Adr(n) is needed to declare word-address bits
+           for functions without device argument.
              n = 0 -> 8-bit word address (Default)
              n = 1 -> 16-bit word address
 
@@ -22,6 +69,9 @@
     Salai Aung Myint Myat
 */
 
+#ifndef FRAM_RX_TX_OPERATION_H
+#define FRAM_RX_TX_OPERATION_H
+
 #include "Master_TWI_Receive.h"
 
 bool Word_Adr_Type = 0;                // '0', Default = 8-bit, '1' = 16-bit
@@ -30,115 +80,471 @@ void FRAM_Word_Adr(bool adr_type) {
   Word_Adr_Type = adr_type;
 }
 
-void FRAM_Write(uint16_t word_adr, uint8_t data) {
-  // Wait with time shifting method
-  Current_Sec = Ref_Sec;
-  while (!(Ref_Sec - Current_Sec > I2C_Shift_Sec)) {}
+//**************** FRAM Device Handle ******************//
+#define FM24CL04B_SIZE      512UL      // 4 Kbit, 8-bit word address
+#define FM24CL16B_SIZE      2048UL     // 16 Kbit, 8-bit word address
+#define MB85RC64_SIZE       8192UL     // 64 Kbit, 16-bit word address
+#define MB85RC256V_SIZE     32768UL    // 256 Kbit, 16-bit word address
+
+#define FRAM_PAGE_SIZE      256        // Bytes per page of 8-bit word address
+#define FRAM_PAGE_MASK_MAX  0x07       // At most 3 page bits in slave address
+
+struct FramDevice {
+  uint8_t sla_wr;                      // Write address
+  uint8_t sla_rd;                      // Read address
+  bool adr_type;                       // '0' = 8-bit, '1' = 16-bit word address
+  uint8_t page_mask;                   // Page bits in 7-bit slave address (8-bit word address)
+  uint32_t capacity;                   // Bytes, 0 = unknown (no range check)
+};
+
+// Page bits for 8-bit word address devices, from capacity
+// (capacity unknown -> no page bits, slave address is used as given)
+uint8_t FRAM_Page_Mask(bool adr_type, uint32_t capacity) {
+  if (adr_type == 1 || capacity == 0) return 0;
+
+  uint32_t pages = (capacity + FRAM_PAGE_SIZE - 1) / FRAM_PAGE_SIZE;
+  uint8_t mask = 0;
+  while ((uint32_t)(mask + 1) < pages && mask < FRAM_PAGE_MASK_MAX) {
+    mask = (mask << 1) | 1;
+  }
+  return mask;
+}
+
+FramDevice FRAM_Device(uint8_t SLA, bool adr_type, uint32_t capacity) {
+  FramDevice dev;
+  dev.adr_type = adr_type;
+  dev.capacity = capacity;
+  dev.page_mask = FRAM_Page_Mask(adr_type, capacity);
+  SLA &= ~dev.page_mask;                        // Page bits come from word address
+  // Slave address convertion
+  dev.sla_wr = (SLA << 1) & ~(1 << RW_BIT);     // 0 - Write operation enabled
+  dev.sla_rd = (SLA << 1) | (1 << RW_BIT);      // 1 - Read operation enabled
+  return dev;
+}
+
+// Device of i2cMaster_Init() and FRAM_Word_Adr() settings,
+// used by functions without device argument
+FramDevice FRAM_Default_Device(void) {
+  FramDevice dev;
+  dev.sla_wr = SLA_WR;
+  dev.sla_rd = SLA_RD;
+  dev.adr_type = Word_Adr_Type;
+  dev.capacity = 0;
+  dev.page_mask = 0;                  // Slave address unchanged, as before handles
+  return dev;
+}
+
+//**************** Address Latch Tracking ******************//
+// FRAM increments its internal address latch after every byte. Next address
+// is kept per chip (slave address bits A0..A2), so a read starting there
+// only needs SLA+R.
+#define FRAM_LATCH_SLOTS    8
 
+struct FramLatch {
+  uint8_t sla_wr;                      // Base write address of chip, 0 = latch unknown
+  uint16_t adr;                        // Next word address in chip
+};
+FramLatch FRAM_Latch[FRAM_LATCH_SLOTS];
+
+uint8_t FRAM_Latch_Slot(uint8_t sla_wr) {
+  return (sla_wr >> 1) & (FRAM_LATCH_SLOTS - 1);
+}
+
+// Forget all latches, next access sends word address again
+void FRAM_Latch_Invalidate(void) {
+  for (uint8_t i = 0; i < FRAM_LATCH_SLOTS; i++) {
+    FRAM_Latch[i].sla_wr = 0;
+  }
+}
+
+// Record latch after transaction, ok = 0 if it was aborted
+// sla_wr is base write address of chip (without page bits)
+void FRAM_Latch_Set(uint8_t sla_wr, uint32_t capacity, uint16_t next_adr, bool ok) {
+  FramLatch& latch = FRAM_Latch[FRAM_Latch_Slot(sla_wr)];
+  if (!ok) {
+    latch.sla_wr = 0;
+    return;
+  }
+  // Latch rolls over at end of chip
+  if (capacity != 0 && next_adr >= capacity) {
+    next_adr -= capacity;
+  }
+  latch.sla_wr = sla_wr;
+  latch.adr = next_adr;
+}
+
+bool FRAM_Latch_Hit(uint8_t sla_wr, uint16_t word_adr) {
+  FramLatch& latch = FRAM_Latch[FRAM_Latch_Slot(sla_wr)];
+  return latch.sla_wr == sla_wr && latch.adr == word_adr;
+}
+
+//**************** Transfer Core ******************//
+// Shared by FramDevice (run-time values) and FramChip (compile-time values,
+// see "Fram_Device_Traits.h"). D gives the chip values:
+//   Base()            - write address without page bits
+//   SLA_Write(adr)    - write address with page bits of word address
+//   Adr_Type()        - '0' = 8-bit, '1' = 16-bit word address
+//   Capacity()        - bytes, 0 = unknown
+//   Span(adr, len)    - bytes up to next page boundary
+//   In_Range(adr, len)
+
+// Record latch after transaction, ok = 0 if it was aborted
+// 8-bit word address without capacity sends no page bits, chip is always
+// addressed in its first page. Latch is only kept while it stays there,
+// past that the chip may be in next page (FM24CL16B) or at page start.
+template <class D>
+void FRAM_Core_Latch_Set(const D& d, uint16_t next_adr, bool ok) {
+  if (d.Adr_Type() == 0 && d.Capacity() == 0 && next_adr > 0xFF) ok = 0;
+  FRAM_Latch_Set(d.Base(), d.Capacity(), next_adr, ok);
+}
+
+// Send START, slave write address and word address
+template <class D>
+void FRAM_Core_Select(const D& d, uint16_t word_adr) {
   // Byte adr shifting
   uint8_t H_adr = (uint8_t)(word_adr >> 8);
   uint8_t L_adr = (uint8_t)(word_adr & 0xFF);
 
-  // FRAM Write Operation
   i2cMaster_Start();
-  i2cMaster_Adr_Write(SLA_WR);
-  if (Word_Adr_Type == 1) {
+  i2cMaster_Adr_Write(d.SLA_Write(word_adr));   // Write slave address
+  if (d.Adr_Type() == 1) {
     i2cMaster_Data_Write(H_adr);
   }
   i2cMaster_Data_Write(L_adr);
+}
+
+// Send START and slave read address, word address only if latch differs
+template <class D>
+void FRAM_Core_Select_Read(const D& d, uint16_t word_adr) {
+  uint8_t sla_rd = d.SLA_Write(word_adr) | (1 << RW_BIT);
+
+  if (FRAM_Latch_Hit(d.Base(), word_adr)) {
+    i2cMaster_Start();
+  }
+  else {
+    FRAM_Core_Select(d, word_adr);
+    i2cMaster_Repeat();
+  }
+  i2cMaster_Adr_Read(sla_rd);          // Read slave address
+}
+
+template <class D>
+bool FRAM_Core_Write(const D& d, uint16_t word_adr, uint8_t data) {
+  FRAM_Core_Select(d, word_adr);
   i2cMaster_Data_Write(data);
+  bool ok = (MasterTX_RX_Error == 0);
+  FRAM_Core_Latch_Set(d, word_adr + 1, ok);
   i2cMaster_Stop();
+  return ok;
 }
 
-void FRAM_Write_Array(uint16_t word_adr, char* temp) {
-  // Wait with time shifting method
-  Current_Sec = Ref_Sec;
-  while (!(Ref_Sec - Current_Sec > I2C_Shift_Sec)) {}
+template <class D>
+bool FRAM_Core_Write_Buffer(const D& d, uint16_t word_adr, const uint8_t* buf, uint16_t len) {
+  if (!d.In_Range(word_adr, len)) return 0;
+  bool ok = 1;
 
-  // Byte adr shifting
-  uint8_t H_adr = (uint8_t)(word_adr >> 8);
-  uint8_t L_adr = (uint8_t)(word_adr & 0xFF);
+  // FRAM Write Operation with buffer, one sequential transaction per page
+  while (len > 0 && ok) {
+    uint16_t n = d.Span(word_adr, len);
 
-  // FRAM Write Operation with array
-  // Set array pointer
-  uint8_t i = 0;
+    FRAM_Core_Select(d, word_adr);
+    // Start writing data, break out if there is error code
+    for (uint16_t i = 0; i < n && MasterTX_RX_Error == 0; i++) {
+      i2cMaster_Data_Write(buf[i]);
+    }
+    ok = (MasterTX_RX_Error == 0);
+    FRAM_Core_Latch_Set(d, word_adr + n, ok);
+    i2cMaster_Stop();
 
-  // FRAM Write Operation
-  i2cMaster_Start();
-  i2cMaster_Adr_Write(SLA_WR);
-  if (Word_Adr_Type == 1) {
-    i2cMaster_Data_Write(H_adr);
+    word_adr += n;
+    buf += n;
+    len -= n;
   }
-  i2cMaster_Data_Write(L_adr);
-  // Start reading data
-  while (temp[i] != '\0') {
-    i2cMaster_Data_Write(temp[i]);
-    i++;
+
+  return ok;
+}
+
+template <class D>
+bool FRAM_Core_Read_Buffer(const D& d, uint16_t word_adr, uint8_t* buf, uint16_t len) {
+  if (!d.In_Range(word_adr, len)) return 0;
+  bool ok = 1;
+
+  // FRAM Read Operation with buffer, one sequential transaction per page
+  while (len > 0 && ok) {
+    uint16_t n = d.Span(word_adr, len);
+
+    // Select word-address location (skipped if latch is already there)
+    FRAM_Core_Select_Read(d, word_adr);
+
+    // Start reading data with ACK, break out if there is error code
+    uint16_t i = 0;
+    for (; i < n - 1 && MasterTX_RX_Error == 0; i++) {
+      buf[i] = i2cMaster_Data_Read();
+    }
+    buf[i] = i2cMaster_Data_Read_N();   // Last byte with NACK, Master will stop read data
+    ok = (MasterTX_RX_Error == 0);
+    FRAM_Core_Latch_Set(d, word_adr + n, ok);
+    i2cMaster_Stop();
+
+    word_adr += n;
+    buf += n;
+    len -= n;
   }
-  i2cMaster_Stop();
+
+  return ok;
 }
 
-char FRAM_Read(uint16_t word_adr) {
-  // Wait with time shifting method
-  Current_Sec = Ref_Sec;
-  while (!(Ref_Sec - Current_Sec > I2C_Shift_Sec)) {}
+// Byte by byte variants for work done while each byte is on the bus
+// (e.g. CRC in "Fram_CRC.h"), k counts bytes of whole transfer. H gives:
+//   Next(k)           - write: byte k to send
+//   Sent(k, data)     - write: byte k is shifting out
+//   Shifting(k)       - read: byte k is shifting in
+//   Received(k, data) - read: byte k has arrived
+template <class D, class H>
+bool FRAM_Core_Write_Hook(const D& d, uint16_t word_adr, uint16_t len, H& h) {
+  if (!d.In_Range(word_adr, len)) return 0;
+  uint16_t k = 0;
+  bool ok = 1;
 
-  // Byte adr shifting
-  uint8_t H_adr = (uint8_t)(word_adr >> 8);
-  uint8_t L_adr = (uint8_t)(word_adr & 0xFF);
+  while (k < len && ok) {
+    uint16_t n = d.Span(word_adr, len - k);
 
-  // FRAM Read Operation
-  // Select word-address location
-  i2cMaster_Start();
-  i2cMaster_Adr_Write(SLA_WR);    // Write slave address
-  if (Word_Adr_Type == 1) {
-    i2cMaster_Data_Write(H_adr);
+    FRAM_Core_Select(d, word_adr);
+    for (uint16_t i = 0; i < n && MasterTX_RX_Error == 0; i++, k++) {
+      uint8_t data = h.Next(k);
+      i2cMaster_Data_Write_Begin(data);
+      h.Sent(k, data);
+      i2cMaster_Data_Write_End();
+    }
+    ok = (MasterTX_RX_Error == 0);
+    FRAM_Core_Latch_Set(d, word_adr + n, ok);
+    i2cMaster_Stop();
+
+    word_adr += n;
   }
-  i2cMaster_Data_Write(L_adr);
 
-  // Read data from current word-address
-  i2cMaster_Repeat();
-  i2cMaster_Adr_Read(SLA_RD);         // Read slave address
-  char data = i2cMaster_Data_Read();  // Start reading data
-  i2cMaster_Data_Read_N();            // Acknowledge that Master will stop read data
-  i2cMaster_Stop();
+  return ok;
+}
 
-  return data;
+template <class D, class H>
+bool FRAM_Core_Read_Hook(const D& d, uint16_t word_adr, uint16_t len, H& h) {
+  if (!d.In_Range(word_adr, len)) return 0;
+  uint16_t k = 0;
+  bool ok = 1;
+
+  while (k < len && ok) {
+    uint16_t n = d.Span(word_adr, len - k);
+
+    FRAM_Core_Select_Read(d, word_adr);
+    for (uint16_t i = 0; i < n && MasterTX_RX_Error == 0; i++, k++) {
+      bool ack = (i < n - 1);               // Last byte of transaction with NACK
+      i2cMaster_Data_Read_Begin(ack);
+      h.Shifting(k);
+      h.Received(k, i2cMaster_Data_Read_End(ack));
+    }
+    ok = (MasterTX_RX_Error == 0);
+    FRAM_Core_Latch_Set(d, word_adr + n, ok);
+    i2cMaster_Stop();
+
+    word_adr += n;
+  }
+
+  return ok;
 }
 
+//**************** FramDevice Operation ******************//
+// Slave write address for word address (page bits folded in)
+uint8_t FRAM_SLA(FramDevice& dev, uint16_t word_adr) {
+  return dev.sla_wr | (((word_adr >> 8) & dev.page_mask) << 1);
+}
 
-char FRAM_Read_Array(uint16_t word_adr, char* temp, uint8_t I2C_BUFFER_SIZE) {
-  // Wait with time shifting method
-  Current_Sec = Ref_Sec;
-  while (!(Ref_Sec - Current_Sec > I2C_Shift_Sec)) {}
+// Bytes from word address which can be moved in one sequential transaction
+uint16_t FRAM_Page_Span(FramDevice& dev, uint16_t word_adr, uint16_t len) {
+  if (dev.page_mask == 0) return len;
+  uint16_t left = FRAM_PAGE_SIZE - (word_adr & (FRAM_PAGE_SIZE - 1));
+  return (len < left) ? len : left;
+}
 
-  // Byte adr shifting
-  uint8_t H_adr = (uint8_t)(word_adr >> 8);
-  uint8_t L_adr = (uint8_t)(word_adr & 0xFF);
+// Check bulk transfer fits in device
+bool FRAM_In_Range(FramDevice& dev, uint16_t word_adr, uint16_t len) {
+  return dev.capacity == 0 || (uint32_t)word_adr + len <= dev.capacity;
+}
 
-  // FRAM Read Operation with array
-  // Set array pointer
-  uint8_t i = 0;
+// Run-time chip values of a device handle for the transfer core
+struct FramDevice_Traits {
+  FramDevice& dev;
 
-  // Select word-address location
-  i2cMaster_Start();
-  i2cMaster_Adr_Write(SLA_WR);    // Write slave address
-  if (Word_Adr_Type == 1) {
-    i2cMaster_Data_Write(H_adr);
+  uint8_t Base(void) const { return dev.sla_wr; }
+  uint8_t SLA_Write(uint16_t word_adr) const { return FRAM_SLA(dev, word_adr); }
+  bool Adr_Type(void) const { return dev.adr_type; }
+  uint32_t Capacity(void) const { return dev.capacity; }
+  uint16_t Span(uint16_t word_adr, uint16_t len) const { return FRAM_Page_Span(dev, word_adr, len); }
+  bool In_Range(uint16_t word_adr, uint16_t len) const { return FRAM_In_Range(dev, word_adr, len); }
+};
+
+FramDevice_Traits FRAM_Traits(FramDevice& dev) {
+  FramDevice_Traits d = {dev};
+  return d;
+}
+
+void FRAM_Latch_Set(FramDevice& dev, uint16_t next_adr, bool ok) {
+  FRAM_Core_Latch_Set(FRAM_Traits(dev), next_adr, ok);
+}
+
+bool FRAM_Latch_Hit(FramDevice& dev, uint16_t word_adr) {
+  return FRAM_Latch_Hit(dev.sla_wr, word_adr);
+}
+
+void FRAM_Select(FramDevice& dev, uint16_t word_adr) {
+  FRAM_Core_Select(FRAM_Traits(dev), word_adr);
+}
+
+void FRAM_Select_Read(FramDevice& dev, uint16_t word_adr) {
+  FRAM_Core_Select_Read(FRAM_Traits(dev), word_adr);
+}
+
+void FRAM_Write(FramDevice& dev, uint16_t word_adr, uint8_t data) {
+  // FRAM Write Operation
+  FRAM_Core_Write(FRAM_Traits(dev), word_adr, data);
+}
+
+bool FRAM_Write_Buffer(FramDevice& dev, uint16_t word_adr, const void* data, uint16_t len) {
+  return FRAM_Core_Write_Buffer(FRAM_Traits(dev), word_adr, (const uint8_t*)data, len);
+}
+
+bool FRAM_Read_Buffer(FramDevice& dev, uint16_t word_adr, void* data, uint16_t len) {
+  return FRAM_Core_Read_Buffer(FRAM_Traits(dev), word_adr, (uint8_t*)data, len);
+}
+
+char FRAM_Read(FramDevice& dev, uint16_t word_adr) {
+  // FRAM Read Operation, single byte with NACK
+  char data = 0;
+  FRAM_Read_Buffer(dev, word_adr, &data, 1);
+  return data;
+}
+
+void FRAM_Write_Array(FramDevice& dev, uint16_t word_adr, char* temp) {
+  // FRAM Write Operation with array, until '\0'
+  FRAM_Write_Buffer(dev, word_adr, temp, strlen(temp));
+}
+
+char* FRAM_Read_Array(FramDevice& dev, uint16_t word_adr, char* temp, uint8_t I2C_BUFFER_SIZE) {
+  // FRAM Read Operation with array, terminated with '\0'
+  FRAM_Read_Buffer(dev, word_adr, temp, I2C_BUFFER_SIZE);
+  temp[I2C_BUFFER_SIZE] = '\0';
+  return temp;
+}
+
+//**************** Streaming Read Cursor ******************//
+// Keeps one sequential read open, every byte is read with ACK.
+// No other transaction can run on the bus until cursor is closed.
+// With 8-bit word address, reading continues into next page as chip rolls
+// over (FM24CL16B does).
+struct FramCursor {
+  FramDevice dev;                      // Device being read
+  uint16_t adr;                        // Word address of next byte
+  bool open;                           // Read transaction is running
+};
+
+bool FRAM_Cursor_Open(FramCursor& cur, FramDevice& dev, uint16_t word_adr) {
+  cur.dev = dev;
+  cur.adr = word_adr;
+  FRAM_Select_Read(dev, word_adr);
+  cur.open = (MasterTX_RX_Error == 0);
+  if (!cur.open) {
+    FRAM_Latch_Set(dev, word_adr, 0);
+    i2cMaster_Stop();
   }
-  i2cMaster_Data_Write(L_adr);
+  return cur.open;
+}
 
-  // Read data from current word-address
-  i2cMaster_Repeat();
-  i2cMaster_Adr_Read(SLA_RD);     // Read slave address
-  // Start reading data
-  for (i = 0; i < I2C_BUFFER_SIZE; i++) {
-    temp[i] = i2cMaster_Data_Read();
+uint8_t FRAM_Cursor_Read(FramCursor& cur) {
+  if (!cur.open) return 0;
+  uint8_t data = i2cMaster_Data_Read();
+  cur.adr++;
+  return data;
+}
+
+bool FRAM_Cursor_Read(FramCursor& cur, void* data, uint16_t len) {
+  uint8_t* buf = (uint8_t*)data;
+  for (uint16_t i = 0; i < len && cur.open; i++) {
+    buf[i] = FRAM_Cursor_Read(cur);
   }
-  i2cMaster_Data_Read_N();        // Acknowledge that Master will stop read data
+  return cur.open && MasterTX_RX_Error == 0;
+}
+
+// One dummy byte is read with NACK to end the read, latch is after it
+bool FRAM_Cursor_Close(FramCursor& cur) {
+  if (!cur.open) return 0;
+  i2cMaster_Data_Read_N();
+  bool ok = (MasterTX_RX_Error == 0);
+  FRAM_Latch_Set(cur.dev, cur.adr + 1, ok);
   i2cMaster_Stop();
+  cur.open = 0;
+  return ok;
+}
 
-  temp[i] = '\0';
-  return temp;
+//**************** Typed Read/Write ******************//
+// One sequential transaction per object (per page with 8-bit word address),
+// no copy in between. Types with own copy constructor or virtual functions
+// are rejected at compile time.
+template <typename T>
+bool FRAM_Put(FramDevice& dev, uint16_t word_adr, const T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Put: type must be trivially copyable");
+  static_assert(sizeof(T) <= 0xFFFF, "FRAM_Put: type is larger than 16-bit length");
+  return FRAM_Write_Buffer(dev, word_adr, &value, sizeof(T));
+}
+
+template <typename T>
+bool FRAM_Get(FramDevice& dev, uint16_t word_adr, T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Get: type must be trivially copyable");
+  static_assert(sizeof(T) <= 0xFFFF, "FRAM_Get: type is larger than 16-bit length");
+  return FRAM_Read_Buffer(dev, word_adr, &value, sizeof(T));
+}
+
+//**************** Functions without device ******************//
+// Use slave address of i2cMaster_Init() and word address type of FRAM_Word_Adr()
+
+void FRAM_Write(uint16_t word_adr, uint8_t data) {
+  FramDevice dev = FRAM_Default_Device();
+  FRAM_Write(dev, word_adr, data);
 }
-
+
+void FRAM_Write_Array(uint16_t word_adr, char* temp) {
+  FramDevice dev = FRAM_Default_Device();
+  FRAM_Write_Array(dev, word_adr, temp);
+}
+
+char FRAM_Read(uint16_t word_adr) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Read(dev, word_adr);
+}
+
+char* FRAM_Read_Array(uint16_t word_adr, char* temp, uint8_t I2C_BUFFER_SIZE) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Read_Array(dev, word_adr, temp, I2C_BUFFER_SIZE);
+}
+
+bool FRAM_Write_Buffer(uint16_t word_adr, const void* data, uint16_t len) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Write_Buffer(dev, word_adr, data, len);
+}
+
+bool FRAM_Read_Buffer(uint16_t word_adr, void* data, uint16_t len) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Read_Buffer(dev, word_adr, data, len);
+}
+
+template <typename T>
+bool FRAM_Put(uint16_t word_adr, const T& value) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Put(dev, word_adr, value);
+}
+
+template <typename T>
+bool FRAM_Get(uint16_t word_adr, T& value) {
+  FramDevice dev = FRAM_Default_Device();
+  return FRAM_Get(dev, word_adr, value);
+}
+
+#endif
@@ -0,0 +1,172 @@
+/*
+    FRAM Stream
+    -----------
+    Header file name - "Fram_Stream.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    FramStream is an Arduino Stream over a FRAM region, so print(),
+    println(), write(), read(), peek() and readBytes() work with FRAM like
+    with Serial or a SD card file:
+      FramStream out(fram1, 0x4000, 1024);
+      out.print("Temp: ");
+      out.println(23.5);
+      out.flush();
+      out.seek(0);
+      while (out.available()) Serial.write(out.read());
+    Bytes go through a RAM buffer of FRAM_STREAM_BUFFER bytes. Contiguous
+    writes are sent as one sequential write transaction when buffer is full,
+    on flush() or when reading/seeking elsewhere. Reads fill buffer with one
+    sequential read transaction.
+
+    Stream has one position for reading and writing (like a file).
+    available() counts bytes from position to length, length is the end of
+    written data (pass it to constructor to read data written before reset).
+
+    If buffered bytes cannot be written (bus error, device not answering)
+    they stay in the buffer, like runs of "Fram_Write_Combine.h": write()
+    returns 0, flush() sets getWriteError() and errors() counts the
+    failures. Next write(), flush() or read tries again.
+
+    NOTES: Call flush() before power down and before accessing the region
+           with other functions. Writes beyond region size are dropped
+           (write() returns 0).
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_STREAM_H
+#define FRAM_STREAM_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_STREAM_BUFFER
+#define FRAM_STREAM_BUFFER  32      // Bytes of RAM buffer
+#endif
+
+class FramStream : public Stream {
+  public:
+    FramStream(FramDevice& dev, uint16_t base, uint16_t size, uint16_t length = 0)
+      : dev_(dev), base_(base), size_(size), length_(length), pos_(0),
+        buf_pos_(0), buf_len_(0), dirty_(0), errors_(0) {}
+
+    size_t write(uint8_t c) {
+      if (pos_ >= size_) return 0;
+
+      // Buffer holds read data or another run, send/drop it first
+      if (buf_len_ > 0 && (!dirty_ || pos_ != buf_pos_ + buf_len_ || buf_len_ == FRAM_STREAM_BUFFER)) {
+        if (!Flush_Buffer()) return 0;
+      }
+      if (buf_len_ == 0) {
+        buf_pos_ = pos_;
+        dirty_ = 1;
+      }
+      buf_[buf_len_++] = c;
+      Advance(1);
+      return 1;
+    }
+
+    size_t write(const uint8_t* buffer, size_t size) {
+      // Long block with empty buffer, write directly without copying
+      if (size >= FRAM_STREAM_BUFFER && (buf_len_ == 0 || Flush_Buffer())) {
+        uint16_t n = (size > (size_t)(size_ - pos_)) ? size_ - pos_ : size;
+        if (!FRAM_Write_Buffer(dev_, base_ + pos_, buffer, n)) return 0;
+        Advance(n);
+        return n;
+      }
+
+      size_t n = 0;
+      while (n < size && write(buffer[n])) {
+        n++;
+      }
+      return n;
+    }
+    using Print::write;
+
+    int available() {
+      return (pos_ < length_) ? length_ - pos_ : 0;
+    }
+
+    int read() {
+      int c = peek();
+      if (c >= 0) pos_++;
+      return c;
+    }
+
+    int peek() {
+      if (pos_ >= length_) return -1;
+      if (dirty_ && !Flush_Buffer()) return -1;
+
+      // Fill buffer from position
+      if (buf_len_ == 0 || pos_ < buf_pos_ || pos_ >= buf_pos_ + buf_len_) {
+        uint16_t n = length_ - pos_;
+        if (n > FRAM_STREAM_BUFFER) n = FRAM_STREAM_BUFFER;
+        buf_len_ = 0;
+        if (!FRAM_Read_Buffer(dev_, base_ + pos_, buf_, n)) return -1;
+        buf_pos_ = pos_;
+        buf_len_ = n;
+      }
+      return buf_[pos_ - buf_pos_];
+    }
+
+    // Send buffered bytes to FRAM, getWriteError() is set if they could
+    // not be written (bytes stay buffered, next flush() tries again)
+    void flush() {
+      Flush_Buffer();
+    }
+
+    // Move position inside region, returns 0 if beyond region size
+    bool seek(uint16_t pos) {
+      if (pos > size_) return 0;
+      pos_ = pos;
+      return 1;
+    }
+
+    uint16_t position(void) { return pos_; }
+    uint16_t size(void) { return size_; }
+    uint16_t length(void) { return length_; }
+
+    // Empty stream, position and length to 0
+    // Returns 0 if buffered bytes could not be written (stream unchanged)
+    bool clear(void) {
+      if (!Flush_Buffer()) return 0;
+      pos_ = 0;
+      length_ = 0;
+      return 1;
+    }
+
+    // Flushes which failed, bytes kept in buffer
+    unsigned long errors(void) { return errors_; }
+
+  private:
+    // Buffer is only dropped after its bytes are in FRAM
+    bool Flush_Buffer(void) {
+      if (dirty_ && !FRAM_Write_Buffer(dev_, base_ + buf_pos_, buf_, buf_len_)) {
+        errors_++;
+        setWriteError();
+        return 0;
+      }
+      buf_len_ = 0;
+      dirty_ = 0;
+      return 1;
+    }
+
+    void Advance(uint16_t n) {
+      pos_ += n;
+      if (pos_ > length_) length_ = pos_;
+    }
+
+    FramDevice dev_;
+    uint16_t base_;                 // Word address of region
+    uint16_t size_;                 // Bytes of region
+    uint16_t length_;               // End of written data
+    uint16_t pos_;                  // Read/write position
+    uint16_t buf_pos_;              // Position of first buffered byte
+    uint8_t buf_len_;               // Bytes in buffer
+    bool dirty_;                    // Buffer holds bytes not written yet
+    unsigned long errors_;          // Flushes failed
+    uint8_t buf_[FRAM_STREAM_BUFFER];
+};
+
+#endif
@@ -0,0 +1,141 @@
+/*
+    FRAM Volume
+    -----------
+    Header file name - "Fram_Volume.h"
+    Must include: "Fram_Rx_Tx_Operation.h"
+                  (already included "Master_TWI.h" and "Master_TWI_Receive.h")
+
+    Description:
+    One linear 32-bit address space over several FRAM chips, concatenated
+    in the order given:
+      FramDevice chips[2] = {fram1, fram2};     // 32 KB + 32 KB
+      FramVolume vol;
+      FRAM_Volume_Begin(vol, chips, 2);
+      FRAM_Volume_Write(vol, 0x7FF0, data, 64); // 16 bytes to fram1, 48 to fram2
+    Bulk reads and writes are split at chip boundaries, each part is one
+    sequential transaction on its chip (and is still split at 256-byte
+    pages of 8-bit word address chips by FRAM_Write_Buffer()).
+
+    Chips may be of different types, each FramDevice needs its capacity.
+
+    NOTES: Volume keeps a copy of the device handles, up to FRAM_VOLUME_CHIPS.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef FRAM_VOLUME_H
+#define FRAM_VOLUME_H
+
+#include "Fram_Rx_Tx_Operation.h"
+
+#ifndef FRAM_VOLUME_CHIPS
+#define FRAM_VOLUME_CHIPS   4       // Max. chips in a volume
+#endif
+
+struct FramVolume {
+  FramDevice chip[FRAM_VOLUME_CHIPS];
+  uint8_t chips;                    // Chips in volume
+  uint32_t size;                    // Bytes of all chips
+};
+
+
+// Returns 0 if there are too many chips or a chip has no capacity
+bool FRAM_Volume_Begin(FramVolume& vol, FramDevice* chips, uint8_t n) {
+  vol.chips = 0;
+  vol.size = 0;
+  if (n > FRAM_VOLUME_CHIPS) return 0;
+
+  for (uint8_t i = 0; i < n; i++) {
+    if (chips[i].capacity == 0) {
+      vol.size = 0;
+      return 0;
+    }
+    vol.chip[i] = chips[i];
+    vol.size += chips[i].capacity;
+  }
+  vol.chips = n;
+  return 1;
+}
+
+uint32_t FRAM_Volume_Size(FramVolume& vol) {
+  return vol.size;
+}
+
+// Chip holding volume address, adr is changed to word address on that chip
+// Returns FRAM_VOLUME_CHIPS if address is beyond volume
+uint8_t FRAM_Volume_Chip(FramVolume& vol, uint32_t& adr) {
+  for (uint8_t i = 0; i < vol.chips; i++) {
+    if (adr < vol.chip[i].capacity) return i;
+    adr -= vol.chip[i].capacity;
+  }
+  return FRAM_VOLUME_CHIPS;
+}
+
+bool FRAM_Volume_Write(FramVolume& vol, uint32_t adr, const void* data, uint16_t len) {
+  const uint8_t* buf = (const uint8_t*)data;
+  if (adr > vol.size || len > vol.size - adr) return 0;    // No 32-bit wrap
+
+  uint8_t i = FRAM_Volume_Chip(vol, adr);
+  while (len > 0) {
+    if (i >= vol.chips) return 0;
+    // Part up to end of chip
+    uint32_t left = vol.chip[i].capacity - adr;
+    uint16_t n = (len < left) ? len : (uint16_t)left;
+    if (!FRAM_Write_Buffer(vol.chip[i], (uint16_t)adr, buf, n)) return 0;
+
+    buf += n;
+    len -= n;
+    adr = 0;                        // Next part at start of next chip
+    i++;
+  }
+  return 1;
+}
+
+bool FRAM_Volume_Read(FramVolume& vol, uint32_t adr, void* data, uint16_t len) {
+  uint8_t* buf = (uint8_t*)data;
+  if (adr > vol.size || len > vol.size - adr) return 0;    // No 32-bit wrap
+
+  uint8_t i = FRAM_Volume_Chip(vol, adr);
+  while (len > 0) {
+    if (i >= vol.chips) return 0;
+    uint32_t left = vol.chip[i].capacity - adr;
+    uint16_t n = (len < left) ? len : (uint16_t)left;
+    if (!FRAM_Read_Buffer(vol.chip[i], (uint16_t)adr, buf, n)) return 0;
+
+    buf += n;
+    len -= n;
+    adr = 0;
+    i++;
+  }
+  return 1;
+}
+
+// Single byte
+bool FRAM_Volume_Write(FramVolume& vol, uint32_t adr, uint8_t data) {
+  uint8_t i = FRAM_Volume_Chip(vol, adr);
+  if (i >= vol.chips) return 0;
+  return FRAM_Write_Buffer(vol.chip[i], (uint16_t)adr, &data, 1);
+}
+
+char FRAM_Volume_Read(FramVolume& vol, uint32_t adr) {
+  uint8_t i = FRAM_Volume_Chip(vol, adr);
+  if (i >= vol.chips) return 0;
+  return FRAM_Read(vol.chip[i], (uint16_t)adr);
+}
+
+// Typed, object may span two chips
+template <typename T>
+bool FRAM_Volume_Put(FramVolume& vol, uint32_t adr, const T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Volume_Put: type must be trivially copyable");
+  static_assert(sizeof(T) <= 0xFFFF, "FRAM_Volume_Put: type larger than 64 KB");
+  return FRAM_Volume_Write(vol, adr, &value, sizeof(T));
+}
+
+template <typename T>
+bool FRAM_Volume_Get(FramVolume& vol, uint32_t adr, T& value) {
+  static_assert(__is_trivially_copyable(T), "FRAM_Volume_Get: type must be trivially copyable");
+  static_assert(sizeof(T) <= 0xFFFF, "FRAM_Volume_Get: type larger than 64 KB");
+  return FRAM_Volume_Read(vol, adr, &value, sizeof(T));
+}
+
+#endif
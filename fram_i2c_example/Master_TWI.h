@@ -1,18 +1,34 @@
 /* Frequencies and Baudrate Definitions
    ------------------------------------
-   MCU = 16 MHz
-   Prescaler = 1
+   MCU = F_CPU from board settings (16 MHz if not defined)
+   Prescaler = selected by i2cMaster_Set_Speed()
    SCL freq tested = 100 kHz, 400 kHz
-   SCL freq seleced = 100 kHz
+   SCL freq default = 100 kHz (SCL_FREQ)
 
     Formula (ref. from ATmega328p datasheet)
     ***********************************************************
-       TWBR Baudrate = [(F_CPU/SCL_Freq) - (16-Prescaler)]/2
+       SCL_Freq = F_CPU / (16 + 2 * TWBR * 4^TWPS)
+       TWBR Baudrate = [(F_CPU/SCL_Freq) - 16] / (2 * 4^TWPS)
     ***********************************************************
 
-  Notes: I2C pinouts in ATmega2560(Arduino Mega Board),
-          SDA = PD1 (digital pin 20)
-          SCL = PD0 (digital pin 21)
+    Bus speed can be selected at runtime:
+      i2cMaster_Set_Speed(400000);         // before i2cMaster_Init()
+      i2cMaster_Init(SLA, 400000);         // or together with init
+    Smallest prescaler which keeps TWBR <= 255 is used, and TWBR is
+    rounded up so SCL never runs faster than requested.
+    Stage timeouts follow bus speed, see "Stage Timeouts" below.
+    Slave holding SDA low is released after dead-loop errors, see "Bus Recovery".
+
+    Default TWBR/TWPS are computed at compile time from F_CPU and SCL_FREQ
+    (define SCL_FREQ before including to change it). Build fails if the
+    speed cannot be reached. Constant speed can also be checked at compile
+    time: i2cMaster_Set_Speed<400000>();
+
+  Notes: I2C pins are selected from board MCU at compile time
+          ATmega328p/168 (UNO, Nano, Pro Mini): SDA = PC4 (A4), SCL = PC5 (A5)
+          ATmega2560/1280 (Mega): SDA = PD1 (digital pin 20), SCL = PD0 (digital pin 21)
+          ATmega32U4 (Leonardo, Micro): SDA = PD1 (digital pin 2), SCL = PD0 (digital pin 3)
+         Other MCUs: define I2C_DDR, I2C_PORT, I2C_PIN, I2C_SDA, I2C_SCL before including.
 
   Date: 17 Sep 2019
 
@@ -20,10 +36,62 @@
   Salai Aung Myint Myat
 */
 
+#ifndef MASTER_TWI_H
+#define MASTER_TWI_H
+
+#ifndef F_CPU
 #define F_CPU   16000000UL  // 16 MHz
+#endif
+#ifndef SCL_FREQ
 #define SCL_FREQ  100000    // 100 kHz
-#define TWPS_PRESCALER  1   // Set prescaler to 1, 4^TWPS = 4^0 = 1
-#define TWBR_BAUD   ((F_CPU/SCL_FREQ)-(16-TWPS_PRESCALER))/2
+#endif
+
+//**************** Bus Timing Calculation ******************//
+// CPU cycles per SCL period, rounded up
+constexpr uint32_t i2cTiming_Cycles(uint32_t scl_freq) {
+  return (F_CPU + scl_freq - 1) / scl_freq;
+}
+
+// TWBR for prescaler bits TWPS, rounded up so SCL is not faster than requested
+constexpr uint32_t i2cTiming_TWBR(uint32_t scl_freq, uint8_t twps) {
+  return (i2cTiming_Cycles(scl_freq) <= 16) ? 0 :
+         (i2cTiming_Cycles(scl_freq) - 16 + (2UL << (2 * twps)) - 1) / (2UL << (2 * twps));
+}
+
+// Smallest prescaler bits which keep TWBR <= 255 (3 if none does)
+constexpr uint8_t i2cTiming_TWPS(uint32_t scl_freq, uint8_t twps = 0) {
+  return (twps >= 3 || i2cTiming_TWBR(scl_freq, twps) <= 255) ? twps : i2cTiming_TWPS(scl_freq, twps + 1);
+}
+
+// Speed can be reached with F_CPU
+constexpr bool i2cTiming_Valid(uint32_t scl_freq) {
+  return scl_freq > 0 && scl_freq <= F_CPU / 16 && i2cTiming_TWBR(scl_freq, 3) <= 255;
+}
+
+static_assert(i2cTiming_Valid(SCL_FREQ), "SCL_FREQ cannot be reached with F_CPU (TWBR/TWPS out of range)");
+#define TWPS_PRESCALER  i2cTiming_TWPS(SCL_FREQ)
+#define TWBR_BAUD       i2cTiming_TWBR(SCL_FREQ, TWPS_PRESCALER)
+
+//**************** Bus Speed Selection ******************//
+uint8_t I2C_TWBR = TWBR_BAUD;       // Baudrate used by i2cMaster_Init()
+uint8_t I2C_TWPS = TWPS_PRESCALER;  // Prescaler bits, 4^TWPS
+
+//**************** Board I2C Pins ******************//
+#ifndef I2C_DDR
+#if defined(__AVR_ATmega2560__) || defined(__AVR_ATmega1280__) || defined(__AVR_ATmega32U4__)
+#define I2C_DDR     DDRD
+#define I2C_PORT    PORTD
+#define I2C_PIN     PIND
+#define I2C_SDA     PD1
+#define I2C_SCL     PD0
+#else
+#define I2C_DDR     DDRC            // ATmega328p, ATmega168
+#define I2C_PORT    PORTC
+#define I2C_PIN     PINC
+#define I2C_SDA     PC4
+#define I2C_SCL     PC5
+#endif
+#endif
 
 //=====================================================//
 //              MASTER CONTROLLER - WRITE              //
@@ -54,34 +122,389 @@ volatile byte MasterTX_RX_Error = 0;
 //**************** Dead Loop Prevention ******************//
 #define Ref_Sec           millis()
 #define Wait_Sec          1         // 1 milli second
-#define I2C_Shift_Sec     10        // 10 milli seconds for time shift waiting
+#define I2C_Shift_Sec     10        // 10 milli seconds for time shift waiting after failed transaction
 unsigned long Current_Sec = 0;      // Manipulate current second with reference second
 
+//**************** Bus Ready Tracking ******************//
+// FRAM has no write cycle time, so next START only waits when hardware is
+// still sending STOP (TWSTO) or last transaction was aborted with error.
+#define I2C_READY         0         // Bus is free, START can be sent at once
+#define I2C_RECOVERING    1         // Last transaction aborted, wait time shift before START
+#define I2C_ASYNC_BUSY    2         // TWI interrupt is running queued transactions
+volatile byte I2C_Bus_State = I2C_READY;
+unsigned long I2C_Recover_Sec = 0;  // Reference second when transaction aborted
+void (*I2C_Async_Drain)(void) = 0;  // Set by "Fram_Async_TWI.h", waits until its queue is empty
+
 //**************** Slave Adr Convertion ******************//
 #define RW_BIT            0         // Bit 0 at slave address for R/W operation
 uint8_t SLA_WR = 0;                 // Write address
 uint8_t SLA_RD = 0;                 // Read address
 
+//**************** Bus Statistics ******************//
+// Define I2C_BUS_STATS before including this header to count bus traffic
+// (START/REPEAT/STOP conditions and bytes on the wire). Compiled out otherwise.
+#ifdef I2C_BUS_STATS
+struct I2C_Stats_t {
+  unsigned long start;              // START conditions
+  unsigned long repeat;             // REPEAT (repeated START) conditions
+  unsigned long stop;               // STOP conditions
+  unsigned long bytes;              // Address and data bytes (9 SCL clocks each)
+};
+I2C_Stats_t I2C_Stats = {0, 0, 0, 0};
+#define I2C_STAT(field)   (I2C_Stats.field++)
+#else
+#define I2C_STAT(field)   ((void)0)
+#endif
+
+//**************** Stage Timeouts ******************//
+// Each stage polls TWCR at most a budget of byte times (9 SCL clocks) at
+// current bus speed, so a hung stage is detected after tens of micro
+// seconds at 400 kHz instead of Wait_Sec. Budgets are counted in poll
+// loops, CPU cycles per loop are measured once by i2cMaster_Bus_Init().
+// Change a budget with i2cMaster_Set_Timeout(stage, byte_times).
+#define I2C_STAGE_START     0       // START condition
+#define I2C_STAGE_REPEAT    1       // REPEAT (repeated START) condition
+#define I2C_STAGE_SLA       2       // Slave address + ACK
+#define I2C_STAGE_DATA      3       // Data byte + ACK
+#define I2C_STAGE_DATA_N    4       // Last data byte + NACK
+#define I2C_STAGE_STOP      5       // STOP condition (TWSTO cleared)
+#define I2C_STAGES          6
+
+#ifndef I2C_TIMEOUT_BYTES
+#define I2C_TIMEOUT_BYTES   3       // Default budget in byte times
+#endif
+#define I2C_CALIBRATE_LOOPS 1000    // Poll loops timed for calibration
+
+uint8_t I2C_Timeout_Bytes[I2C_STAGES] = {
+  I2C_TIMEOUT_BYTES, I2C_TIMEOUT_BYTES, I2C_TIMEOUT_BYTES,
+  I2C_TIMEOUT_BYTES, I2C_TIMEOUT_BYTES, I2C_TIMEOUT_BYTES
+};
+uint8_t I2C_Poll_Cycles = 0;        // CPU cycles per poll loop, 0 = not measured
+uint32_t I2C_Byte_Loops = 0;        // Poll loops per byte time at current speed
+
+//**************** Bus Trace ******************//
+// Define I2C_TRACE before including this header to record, per stage, a
+// histogram of wait time (CPU cycles, log2 bins), a count of every error
+// code and finished/aborted transactions. Compiled out otherwise.
+//   bin 0: < 128 cycles, bin n: < 128 << n cycles, last bin: all longer
+//   i2cTrace_Dump_CSV(Serial);      // text, one row per stage and error
+//   i2cTrace_Dump_Binary(Serial);   // compact, little endian
+#ifdef I2C_TRACE
+#define I2C_TRACE_BINS      8       // Histogram bins per stage
+#define I2C_TRACE_BIN0      7       // log2 of first bin limit (128 cycles)
+#define I2C_TRACE_ERRORS    24      // Error code slots, see i2cTrace_Error_Slot()
+
+struct I2C_Trace_t {
+  uint16_t hist[I2C_STAGES][I2C_TRACE_BINS];  // Waits per stage and bin
+  uint16_t errors[I2C_TRACE_ERRORS];          // Errors per code
+  unsigned long txn;                          // Transactions finished with STOP
+  unsigned long aborted;                      // Transactions aborted with error
+};
+I2C_Trace_t I2C_Trace;
+uint32_t I2C_Trace_Left = 0;        // Poll loops left when last wait finished
+
+const char* const I2C_Trace_Stage_Name[I2C_STAGES] = {
+  "START", "REPEAT", "SLA", "DATA", "DATA_N", "STOP"
+};
+
+// Error codes 0x01-0x07 (MTX), 0x11-0x18 (MRX), 0x21-0x23 (ASYNC) to slots
+uint8_t i2cTrace_Error_Slot(uint8_t code)
+{
+  return (((code >> 4) & 0x03) << 3) | (code & 0x07);
+}
+
+uint8_t i2cTrace_Error_Code(uint8_t slot)
+{
+  uint8_t code = ((slot >> 3) << 4) | (slot & 0x07);
+  return ((slot & 0x07) == 0) ? ((slot == 8) ? 0x18 : 0) : code;   // 0x18 uses free slot of 0x10
+}
+
+// Record wait of stage which used loops of budget
+void i2cTrace_Stage(uint8_t stage, uint32_t loops)
+{
+  uint32_t cycles = loops * I2C_Poll_Cycles;
+  uint8_t bin = 0;
+  while (bin < I2C_TRACE_BINS - 1 && (cycles >> (I2C_TRACE_BIN0 + bin)) != 0) {
+    bin++;
+  }
+  if (I2C_Trace.hist[stage][bin] != 0xFFFF) I2C_Trace.hist[stage][bin]++;
+}
+
+void i2cTrace_Error(uint8_t code)
+{
+  uint8_t slot = i2cTrace_Error_Slot(code);
+  if (code != 0 && I2C_Trace.errors[slot] != 0xFFFF) I2C_Trace.errors[slot]++;
+}
+
+void i2cTrace_Reset(void)
+{
+  memset(&I2C_Trace, 0, sizeof(I2C_Trace));
+}
+
+// Text dump:
+//   stage,<name>,<bin 0>,...,<bin 7>
+//   error,<code hex>,<count>         (only codes seen)
+//   txn,<finished>,<aborted>
+void i2cTrace_Dump_CSV(Print& out)
+{
+  for (uint8_t s = 0; s < I2C_STAGES; s++) {
+    out.print(F("stage,"));
+    out.print(I2C_Trace_Stage_Name[s]);
+    for (uint8_t b = 0; b < I2C_TRACE_BINS; b++) {
+      out.print(',');
+      out.print(I2C_Trace.hist[s][b]);
+    }
+    out.println();
+  }
+  for (uint8_t e = 0; e < I2C_TRACE_ERRORS; e++) {
+    if (I2C_Trace.errors[e] == 0) continue;
+    out.print(F("error,0x"));
+    out.print(i2cTrace_Error_Code(e), HEX);
+    out.print(',');
+    out.println(I2C_Trace.errors[e]);
+  }
+  out.print(F("txn,"));
+  out.print(I2C_Trace.txn);
+  out.print(',');
+  out.println(I2C_Trace.aborted);
+}
+
+// Binary dump, all values little endian:
+//   'T', 'R', stages, bins, error slots, poll cycles,
+//   hist (uint16 stage by stage), errors (uint16 by slot),
+//   txn (uint32), aborted (uint32)
+void i2cTrace_Dump_Binary(Print& out)
+{
+  uint8_t head[6] = {'T', 'R', I2C_STAGES, I2C_TRACE_BINS, I2C_TRACE_ERRORS, I2C_Poll_Cycles};
+  out.write(head, sizeof(head));
+
+  const uint16_t* w = &I2C_Trace.hist[0][0];
+  for (uint16_t i = 0; i < I2C_STAGES * I2C_TRACE_BINS + I2C_TRACE_ERRORS; i++) {
+    out.write((uint8_t)(w[i] & 0xFF));   // hist and errors are contiguous
+    out.write((uint8_t)(w[i] >> 8));
+  }
+  unsigned long count[2] = {I2C_Trace.txn, I2C_Trace.aborted};
+  for (uint8_t c = 0; c < 2; c++) {
+    for (uint8_t i = 0; i < 4; i++) {
+      out.write((uint8_t)(count[c] >> (8 * i)));
+    }
+  }
+}
+
+#define I2C_TRACE_STAGE(stage, loops)   i2cTrace_Stage(stage, loops)
+#define I2C_TRACE_LEFT(loops)           (I2C_Trace_Left = (loops))
+#define I2C_TRACE_ERROR(code)           i2cTrace_Error(code)
+#define I2C_TRACE_TXN(ok)               ((ok) ? I2C_Trace.txn++ : I2C_Trace.aborted++)
+#else
+#define I2C_TRACE_STAGE(stage, loops)   ((void)0)
+#define I2C_TRACE_LEFT(loops)           ((void)0)
+#define I2C_TRACE_ERROR(code)           ((void)0)
+#define I2C_TRACE_TXN(ok)               ((void)0)
+#endif
+
+//**************** Stage Wait ******************//
+// Poll TWCR until (TWCR & mask) == value, at most loops times
+// Returns 0 if it timed out. Not inlined, so calibration times same code.
+__attribute__((noinline)) bool i2cMaster_Poll(uint8_t mask, uint8_t value, uint32_t loops)
+{
+  while ((TWCR & mask) != value) {
+    if (--loops == 0) return 0;
+  }
+  I2C_TRACE_LEFT(loops);
+  return 1;
+}
+
+// Measure poll loop once, then convert byte time of current speed to loops
+void i2cMaster_Calibrate_Timeout(void)
+{
+  if (I2C_Poll_Cycles == 0) {
+    unsigned long us = micros();
+    i2cMaster_Poll(0, 1, I2C_CALIBRATE_LOOPS);      // Never matches, runs all loops
+    us = micros() - us;
+    uint32_t cycles = (us * (F_CPU / 1000000UL)) / I2C_CALIBRATE_LOOPS;
+    I2C_Poll_Cycles = (cycles == 0) ? 1 : (cycles > 255) ? 255 : cycles;
+  }
+
+  uint32_t scl_cycles = 16 + 2UL * I2C_TWBR * (1UL << (2 * I2C_TWPS));
+  I2C_Byte_Loops = (9 * scl_cycles) / I2C_Poll_Cycles + 1;
+}
+
+uint32_t I2C_Stage_Loops(uint8_t stage)
+{
+  if (I2C_Byte_Loops == 0) i2cMaster_Calibrate_Timeout();
+  return I2C_Byte_Loops * I2C_Timeout_Bytes[stage];
+}
+
+// Budget of one stage in byte times (at least 1)
+void i2cMaster_Set_Timeout(uint8_t stage, uint8_t byte_times)
+{
+  if (stage < I2C_STAGES) {
+    I2C_Timeout_Bytes[stage] = (byte_times == 0) ? 1 : byte_times;
+  }
+}
+
+// Wait (TWCR & mask) == value, returns 0 if budget of stage is exceeded
+bool i2cMaster_Wait_Stage(uint8_t stage, uint8_t mask, uint8_t value)
+{
+  uint32_t loops = I2C_Stage_Loops(stage);
+  bool ok = i2cMaster_Poll(mask, value, loops);
+  I2C_TRACE_STAGE(stage, ok ? loops - I2C_Trace_Left : loops);
+  return ok;
+}
+
+// Wait TWINT is set by hardware, returns 0 if budget of stage is exceeded
+bool i2cMaster_Wait_TWINT(uint8_t stage)
+{
+  return i2cMaster_Wait_Stage(stage, (1 << TWINT), (1 << TWINT));
+}
+
+//**************** Bus Recovery ******************//
+// A slave interrupted in the middle of a byte keeps SDA low until it gets
+// the rest of its clocks. TWI cannot clock SCL then, so every START would
+// burn its whole timeout. Recovery takes the pins from TWI, clocks SCL up
+// to 9 times until SDA is released, sends a STOP by hand and enables TWI
+// again. It runs automatically after dead-loop errors (i2cMaster_Stop()),
+// or call i2cMaster_Bus_Recover() directly.
+#define I2C_RECOVER_PULSES  9       // One byte and ACK bit
+#define I2C_RECOVER_US      5       // Half SCL period, ~100 kHz
+#define I2C_STRETCH_US      100     // Max. SCL held low by slave per pulse
+
+struct I2C_Recovery_t {
+  unsigned long count;              // Recoveries run
+  unsigned long stuck;              // Recoveries which found SDA low
+  unsigned long pulses;             // SCL pulses clocked by hand
+  unsigned long failed;             // SDA still low after recovery
+};
+I2C_Recovery_t I2C_Recovery = {0, 0, 0, 0};
+
+// Open-drain pin control, line is low only while driven
+void i2cMaster_Pin_Low(uint8_t pin)
+{
+  I2C_PORT &= ~(1 << pin);          // Pull-up off
+  I2C_DDR |= (1 << pin);            // Drive low
+}
+
+void i2cMaster_Pin_Release(uint8_t pin)
+{
+  I2C_DDR &= ~(1 << pin);           // Input
+  I2C_PORT |= (1 << pin);           // Pull-up on
+}
+
+bool i2cMaster_Pin_High(uint8_t pin)
+{
+  return (I2C_PIN & (1 << pin)) != 0;
+}
+
+// Bus is stuck if a slave holds SDA low while SCL is released
+bool i2cMaster_Bus_Stuck(void)
+{
+  return i2cMaster_Pin_High(I2C_SCL) && !i2cMaster_Pin_High(I2C_SDA);
+}
+
+// Release slave holding SDA, send STOP and enable TWI again
+// Returns 1 if bus is free
+bool i2cMaster_Bus_Recover(void)
+{
+  I2C_Recovery.count++;
+
+  // 1. Take pins from TWI, both lines released
+  TWCR = 0;
+  i2cMaster_Pin_Release(I2C_SDA);
+  i2cMaster_Pin_Release(I2C_SCL);
+  delayMicroseconds(I2C_RECOVER_US);
+
+  // 2. Clock SCL until slave releases SDA
+  if (!i2cMaster_Pin_High(I2C_SDA)) {
+    I2C_Recovery.stuck++;
+    for (uint8_t i = 0; i < I2C_RECOVER_PULSES && !i2cMaster_Pin_High(I2C_SDA); i++) {
+      i2cMaster_Pin_Low(I2C_SCL);
+      delayMicroseconds(I2C_RECOVER_US);
+      i2cMaster_Pin_Release(I2C_SCL);
+      for (uint8_t t = 0; t < I2C_STRETCH_US && !i2cMaster_Pin_High(I2C_SCL); t++) {
+        delayMicroseconds(1);       // Slave stretches clock
+      }
+      delayMicroseconds(I2C_RECOVER_US);
+      I2C_Recovery.pulses++;
+    }
+  }
+
+  // 3. STOP condition: SDA low -> high while SCL is high
+  i2cMaster_Pin_Low(I2C_SCL);
+  i2cMaster_Pin_Low(I2C_SDA);
+  delayMicroseconds(I2C_RECOVER_US);
+  i2cMaster_Pin_Release(I2C_SCL);
+  delayMicroseconds(I2C_RECOVER_US);
+  i2cMaster_Pin_Release(I2C_SDA);
+  delayMicroseconds(I2C_RECOVER_US);
+
+  // 4. Enable TWI again
+  TWBR = I2C_TWBR;
+  TWSR = I2C_TWPS;
+  TWCR = (1 << TWEN);
+
+  bool free = i2cMaster_Pin_High(I2C_SDA) && i2cMaster_Pin_High(I2C_SCL);
+  if (!free) I2C_Recovery.failed++;
+  return free;
+}
+
+// Error codes of stages which did not finish (bus may be stuck)
+bool i2cMaster_Dead_Loop(uint8_t error)
+{
+  return (error >= MTX_START_dead_loop && error <= MTX_STOP_dead_loop) ||
+         (error >= 0x15 && error <= 0x18);    // MRX_REPEAT_dead_loop ... MRX_DATA_N_dead_loop
+}
+
 // Error detection functions
 void MTX_RX_ERROR(void);
 
 
-// Master device initialization
-void i2cMaster_Init(uint8_t SLA)
+// Select SCL frequency, computes TWBR and TWPS prescaler for F_CPU
+// Returns 0 if frequency cannot be reached (nearest possible one is selected)
+bool i2cMaster_Set_Speed(uint32_t scl_freq)
+{
+  if (scl_freq == 0) return 0;
+
+  I2C_TWPS = i2cTiming_TWPS(scl_freq);
+  uint32_t twbr = i2cTiming_TWBR(scl_freq, I2C_TWPS);
+  I2C_TWBR = (twbr > 255) ? 255 : (uint8_t)twbr;   // Slower than hardware can go, use slowest
+  return i2cTiming_Valid(scl_freq);
+}
+
+// Select constant SCL frequency, build fails if it cannot be reached
+template <uint32_t SCL>
+void i2cMaster_Set_Speed(void)
+{
+  static_assert(i2cTiming_Valid(SCL), "SCL frequency cannot be reached with F_CPU");
+  I2C_TWBR = i2cTiming_TWBR(SCL, i2cTiming_TWPS(SCL));
+  I2C_TWPS = i2cTiming_TWPS(SCL);
+}
+
+// Actual SCL frequency of current speed selection
+uint32_t i2cMaster_Get_Speed(void)
+{
+  return F_CPU / (16 + 2UL * I2C_TWBR * (1UL << (2 * I2C_TWPS)));
+}
+
+// Master bus initialization (pins, baudrate), no slave address
+// Needed once when FRAM device handles ("Fram_Rx_Tx_Operation.h") are used
+void i2cMaster_Bus_Init(void)
 {
   // Pull-up to SCL and SDA bus lines
   // Otherwise, use 1 kOhm resistor
-  // Comment this if ATmega2560 (Mega board) is used
-  DDRC &= ~((1 << DDC4) | (1 << DDC5));       // Set as input direction
-  PORTC |= (1 << PC4) | (1 << PC5);           // Set pull-up resistor
-
-  // Uncomment this if ATmega2560 (Mega board) is used
-  //  DDRD &= ~((1 << DDD1) | (1 << DDD0));   // Set as input direction
-  //  PORTD |= (1 << PD1) | (1 << PD0);       // Set pull-up resistor
+  I2C_DDR &= ~((1 << I2C_SDA) | (1 << I2C_SCL));    // Set as input direction
+  I2C_PORT |= (1 << I2C_SDA) | (1 << I2C_SCL);      // Set pull-up resistor
 
-  TWBR = TWBR_BAUD;   // Set baudrate by calculation from Datasheet
+  TWBR = I2C_TWBR;    // Set baudrate by calculation from Datasheet
   TWCR = (1 << TWEN); // TWI enabled
-  TWSR = 0;           // Set prescaler to 1
+  TWSR = I2C_TWPS;    // Set prescaler
+  i2cMaster_Calibrate_Timeout();
+  I2C_Bus_State = I2C_READY;
+}
+
+// Master device initialization
+void i2cMaster_Init(uint8_t SLA)
+{
+  i2cMaster_Bus_Init();
 
   // Slave address convertion
   uint8_t SlaveAdr = (SLA << 1);        // Convert slave address (7 to 8 bits)
@@ -96,17 +519,21 @@ void i2cMaster_Init(uint8_t SLA)
 }
 
 
+// Master device initialization with SCL frequency
+bool i2cMaster_Init(uint8_t SLA, uint32_t scl_freq)
+{
+  bool ok = i2cMaster_Set_Speed(scl_freq);
+  i2cMaster_Init(SLA);
+  return ok;
+}
+
+
 // Master device disable
 void i2cMaster_Disable(void)
 {
   // Pull-down to SCL and SDA bus lines
-  // Comment this if ATmega2560 (Mega board) is used
-  DDRC |= (1 << DDC4) | (1 << DDC5);         // Set as output direction
-  PORTC &= ~((1 << PC4) | (1 << PC5));       // Set low logic
-
-  // Uncomment this if ATmega2560 (Mega board) is used
-  //  DDRD |= (1 << DDD1) | (1 << DDD0);     // Set as input direction
-  //  PORTD &= ~((1 << PD1) | (1 << PD0));   // Set low logic
+  I2C_DDR |= (1 << I2C_SDA) | (1 << I2C_SCL);       // Set as output direction
+  I2C_PORT &= ~((1 << I2C_SDA) | (1 << I2C_SCL));   // Set low logic
 
   TWCR = 0;            // Clear all bits in control register
   TWBR = 0;            // Clear also buadrate
@@ -118,6 +545,7 @@ void i2cMaster_Disable(void)
 /*
     TWI Transmission
     ----------------
+    0. Wait bus is ready (inside START)
     1. Send START condition
     2. Send Slave Address
     3. Send Send Word Address
@@ -125,25 +553,50 @@ void i2cMaster_Disable(void)
     5. Send STOP condition
 */
 
+// 0. Wait bus is ready
+void i2cMaster_Wait_Ready(void)
+{
+  // Interrupt driven transfers own the bus, let them finish first
+  if (I2C_Bus_State == I2C_ASYNC_BUSY && I2C_Async_Drain) {
+    I2C_Async_Drain();
+  }
+
+  // Aborted transaction, give slave time shift before next START
+  if (I2C_Bus_State == I2C_RECOVERING) {
+    while (!(Ref_Sec - I2C_Recover_Sec > I2C_Shift_Sec)) {}
+    I2C_Bus_State = I2C_READY;
+  }
+
+  // STOP condition is still transmitting, TWSTO is cleared by hardware when done
+  // Avoid while dead-loop by BREAKING after the specified time
+  if ((TWCR & (1 << TWSTO)) && !i2cMaster_Wait_Stage(I2C_STAGE_STOP, (1 << TWSTO), 0))
+  { // If wait condition exceeded, then break
+    MasterTX_RX_Error = MTX_STOP_dead_loop;
+    MTX_RX_ERROR();
+    MasterTX_RX_Error = 0;   // Clear error code for resending data
+    i2cMaster_Bus_Recover(); // Clean STOP by hand, TWI enabled again
+    return;
+  }
+}
+
 // 1. Send START condition
 void i2cMaster_Start(void)
 {
+  i2cMaster_Wait_Ready();
+
   TWCR = (1 << TWEN)  |    // TWI enabled
          (1 << TWINT) |    // Enable TWI interrupt
          (1 << TWSTA);     // Enable START bit to transmit
+  I2C_STAT(start);
 
   // Check and wait START condition is transmitted
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      MasterTX_RX_Error = MTX_START_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(I2C_STAGE_START))
+  { // If wait condition exceeded, then break
+    MasterTX_RX_Error = MTX_START_dead_loop;
+    MTX_RX_ERROR();
+    return;
   }
   //---------------------------------------------------------------//
 
@@ -151,7 +604,7 @@ void i2cMaster_Start(void)
   if ((TWSR & 0xF8) != TWI_START) {
     MasterTX_RX_Error = MTX_START_not_reach;
     MTX_RX_ERROR();
-    return 0;
+    return;
   }
   else {
     MasterTX_RX_Error = 0;     // No error
@@ -162,24 +615,21 @@ void i2cMaster_Start(void)
 void i2cMaster_Adr_Write(unsigned char Addr)
 {
   /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
+  if (MasterTX_RX_Error > 0) return;
 
   TWDR = Addr;            // Load address into TWDR register
   TWCR = (1 << TWINT) |   // Clear TWINT to start transmission
          (1 << TWEN);
+  I2C_STAT(bytes);
 
   // Check and wait SLA+W is transmitted and ACK is received
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      MasterTX_RX_Error = MTX_ADR_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(I2C_STAGE_SLA))
+  { // If wait condition exceeded, then break
+    MasterTX_RX_Error = MTX_ADR_dead_loop;
+    MTX_RX_ERROR();
+    return;
   }
   //---------------------------------------------------------------//
 
@@ -187,36 +637,41 @@ void i2cMaster_Adr_Write(unsigned char Addr)
   if ((TWSR & 0xF8) != TWI_MTX_ADR_ACK) {
     MasterTX_RX_Error = MTX_ADR_not_reach;
     MTX_RX_ERROR();
-    return 0;
+    return;
   }
   else {
     MasterTX_RX_Error = 0;     // No error
   }
 }
 
-// 3. Send data to slave
-void i2cMaster_Data_Write(unsigned char Data)
+// 3a. Start sending data to slave, returns while byte is shifting
+// (CPU work between Begin and End overlaps with the bus)
+void i2cMaster_Data_Write_Begin(unsigned char Data)
 {
   /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
+  if (MasterTX_RX_Error > 0) return;
   //  Serial.println("Next");
 
   TWDR = Data;            // Load data into TWDR register
   TWCR = (1 << TWINT) |   // Clear TWINT to start transmission
          (1 << TWEN);
+  I2C_STAT(bytes);
+}
+
+// 3b. Wait data is sent to slave
+void i2cMaster_Data_Write_End(void)
+{
+  /*** If there is error code, then out of the loop ***/
+  if (MasterTX_RX_Error > 0) return;
 
   // Check and wait DATA is transmitted and ACK is received
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      MasterTX_RX_Error = MTX_DATA_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(I2C_STAGE_DATA))
+  { // If wait condition exceeded, then break
+    MasterTX_RX_Error = MTX_DATA_dead_loop;
+    MTX_RX_ERROR();
+    return;
   }
   //---------------------------------------------------------------//
 
@@ -224,44 +679,49 @@ void i2cMaster_Data_Write(unsigned char Data)
   if ((TWSR & 0xF8) != TWI_MTX_DATA_ACK) {
     MasterTX_RX_Error = MTX_DATA_not_reach;
     MTX_RX_ERROR();
-    return 0;
+    return;
   }
   else {
     MasterTX_RX_Error = 0;     // No error
   }
 }
 
+// 3. Send data to slave
+void i2cMaster_Data_Write(unsigned char Data)
+{
+  i2cMaster_Data_Write_Begin(Data);
+  i2cMaster_Data_Write_End();
+}
+
 // 4. Send STOP condition
 void i2cMaster_Stop(void)
 {
   /*** If there is error code, then out of the loop ***/
   if (MasterTX_RX_Error > 0) {
+    I2C_TRACE_TXN(0);
+    // Stage did not finish, slave may hold SDA low
+    if (i2cMaster_Dead_Loop(MasterTX_RX_Error) && i2cMaster_Bus_Recover()) {
+      MasterTX_RX_Error = 0;
+      I2C_Bus_State = I2C_READY;
+      return;
+    }
     MasterTX_RX_Error = 0;   // Clear error code for resending data
     // reset TWCR register
     TWCR = 0;
     TWCR = (1 << TWEN); // TWI enabled
-    return 0;
+    // Hold off next START with time shift
+    I2C_Recover_Sec = Ref_Sec;
+    I2C_Bus_State = I2C_RECOVERING;
+    return;
   }
 
   TWCR = (1 << TWINT) | (1 << TWEN) |
          (1 << TWSTO);  // Enable STOP bit
+  I2C_STAT(stop);
+  I2C_TRACE_TXN(1);
 
-  // Check and wait STOP bit is enable
-  // Avoid while dead-loop by BREAKING after the specified time
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWSTO)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      MasterTX_RX_Error = MTX_STOP_dead_loop;
-      MTX_RX_ERROR();
-      MasterTX_RX_Error = 0;   // Clear error code for resending data
-      // reset TWCR register
-      TWCR = 0;
-      TWCR = (1 << TWEN); // TWI enabled
-      return 0;
-    }
-  }
+  // No waiting here, TWSTO is checked by i2cMaster_Wait_Ready()
+  // before next START, so caller is free while STOP is transmitting.
 
   //  Error = 0;    // Clear out error
 }
@@ -270,6 +730,8 @@ void i2cMaster_Stop(void)
 // Error detection function
 void MTX_RX_ERROR(void)
 {
+  I2C_TRACE_ERROR(MasterTX_RX_Error);
+
   // Printout error bit and suggestion for troubleshooting
   //  Serial.println("------");
   //  Serial.print("Error bit: ");
@@ -279,4 +741,5 @@ void MTX_RX_ERROR(void)
   //  Serial.println();
   //  Error = MasterTX_RX_Error;
 }
-
+
+#endif
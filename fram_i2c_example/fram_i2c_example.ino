@@ -7,14 +7,15 @@
     Tested Boards: Arduino UNO, Nano (Atmega328p MCU)
     MCU Clock: 16 MHz
     Tested I2C Device: FM24CL16B FRAM (Waveshare),
-                       MB85RC256V FRAM
+                       MB85RC256V FRAM,
+                       FM24CL04B FRAM (Test 7, 8-bit word address)
 
     *****************************************************************************
     **Notes - Don't forget to check MCU clock if another Arduino board is used.**
     **        (e.g. Pro Mini 3.3v, 8MHz)                                       **
     *****************************************************************************
-    **Caution - If Mega board is used, don't forget to uncomment and comment   **
-    **          ports at i2cMaster_Init() in "Master_TWI.h" header.            **
+    **Caution - I2C pins are selected from board MCU (UNO/Nano, Mega,         **
+    **          Leonardo). For other MCUs, see "Master_TWI.h" header.          **
     *****************************************************************************
     !!UPDATED: - Additional function that terminate I2C communication protocol.
                  "i2cMaster_Disable()"
@@ -22,11 +23,47 @@
                  "FRAM_Word_Adr(n)"
                  n = 0 -> 8-bit word address (Default)
                  n = 1 -> 16-bit word address
-
-    ##WARNING##
-    Two different FRAM types (FM24CL16B and MB85RC256V) cannot use at the same time.
-    Because it will make faulty memory saving and reading.
-    --> Therefore, only use 1 type of FRAM, same FRAMs can use in parallel.
+               - Interrupt driven background read/write with queue
+                 "Fram_Async_TWI.h"
+               - Combine contiguous single byte writes into one transaction
+                 "Fram_Write_Combine.h"
+               - Binary-safe buffer read/write with 16-bit length
+                 "FRAM_Write_Buffer(adr, data, len)"
+                 "FRAM_Read_Buffer(adr, data, len)"
+               - Per-device handle, all functions take FramDevice as first argument
+                 "FRAM_Device(SLA, adr_type, capacity)"
+               - Current-address reads and streaming read cursor
+                 "FRAM_Cursor_Open(cur, dev, adr)", "FRAM_Cursor_Read(cur)"
+               - Write-back RAM line cache for hot bytes
+                 "Fram_Cache.h"
+               - Read-ahead for sequential single byte reads
+                 "Fram_Prefetch.h"
+               - Ring-buffer data logger with power-fail safe head pointer
+                 "Fram_Log.h"
+               - Key-value store with hashed bucket table
+                 "Fram_KV.h"
+               - Typed read/write of structs, floats, arrays
+                 "FRAM_Put(dev, adr, value)", "FRAM_Get(dev, adr, value)"
+               - Compile-time device type and address checks
+                 "Fram_Device_Traits.h", "FramChip<MB85RC256V, 0x50>"
+               - Bus timing computed and checked at compile time, I2C pins
+                 selected from board MCU (no more comment in/out for Mega)
+               - Arduino Stream over FRAM region, print() straight into FRAM
+                 "Fram_Stream.h"
+               - Optional bus trace, stage wait histograms and error counts
+                 "#define I2C_TRACE", "i2cTrace_Dump_CSV(Serial)"
+               - Double-buffered write pipeline with backpressure
+                 "Fram_Pipeline.h"
+               - One address space over several chips, split at chip ends
+                 "Fram_Volume.h"
+               - Mirrored pair with check value fallback and resync
+                 "Fram_Mirror.h"
+               - CRC-16/CRC-32 computed while bytes are on the bus,
+                 checksummed blocks "Fram_CRC.h"
+               - Bus recovery, SCL clocked by hand to free slave holding SDA
+                 "i2cMaster_Bus_Recover()", automatic after dead-loop errors
+               - TWI stage timeouts in byte times of bus speed (not 1 ms)
+                 "i2cMaster_Set_Timeout(stage, byte_times)"
 
     Date: 3 Oct 2019
 
@@ -35,10 +72,49 @@
 
 */
 
+//#define I2C_TRACE                     // Stage wait histograms and error counts (Test 16), uses SRAM
 #include "Fram_Rx_Tx_Operation.h"
+#include "Fram_Async_TWI.h"
+#include "Fram_Pipeline.h"
+#include "Fram_Write_Combine.h"
+#include "Fram_Cache.h"
+#include "Fram_Prefetch.h"
+#include "Fram_Log.h"
+#include "Fram_KV.h"
+#include "Fram_Device_Traits.h"
+#include "Fram_Stream.h"
+#include "Fram_Volume.h"
+#include "Fram_Mirror.h"
+#include "Fram_CRC.h"
 
 #define FRAM_ADR_1            0x50
-//#define FRAM_ADR_2            0x51
+#define FRAM_ADR_2            0x51
+#define FRAM_ADR_3            0x54              // FM24CL04B, page 1 answers on 0x55
+
+typedef FramChip<MB85RC256V, FRAM_ADR_1> Fram1;   // Same chip as fram1 in Test 7
+
+volatile uint8_t async_done = 0;
+
+// Buffers of Tests 6, 15, 18 and 21, one test at a time.
+// Global, so they are not on the stack of setup() (UNO has 2 KB SRAM).
+union {
+  uint8_t blk[300];
+  char line[32];
+  uint8_t ring[80];
+  uint8_t stored[100];
+} test_buf;
+
+// Settings stored as one object
+struct Settings {
+  uint8_t mode;
+  int16_t offset;
+  float gain;
+};
+
+// Called from TWI interrupt when transaction is finished
+void Async_Complete(FramAsync_Txn* /*txn*/) {
+  async_done++;
+}
 
 void setup() {
   Serial.begin(9600);
@@ -116,6 +192,424 @@ void setup() {
   Serial.print("Char: ");
   Serial.println(c2);
   Serial.println();
+
+
+  //-------------TEST 4-------------//
+  //*******Background Write and Read*******/
+  Serial.println("---Test 4: Async Write/Read---");
+
+  FramAsync_Txn tx_wr, tx_rd;
+  uint8_t bg_wr[] = "BACKGROUND";
+  uint8_t bg_rd[11] = {0};
+  unsigned long work = 0;
+
+  i2cMaster_Init(FRAM_ADR_1);
+  FRAM_Word_Adr(1);           // 1 for 16-bit word address type
+  FRAM_Async_Write(&tx_wr, 0x40, bg_wr, 10, Async_Complete);
+  FRAM_Async_Read(&tx_rd, 0x40, bg_rd, 10, Async_Complete);
+  // CPU is free while transactions are running
+  while (!FRAM_Async_Idle()) {
+    work++;
+  }
+  FRAM_Async_Wait(&tx_rd);
+  i2cMaster_Disable();
+
+  Serial.print("Print Str: ");
+  Serial.println((char*)bg_rd);
+  Serial.print("Callbacks: ");
+  Serial.println(async_done);
+  Serial.print("Loop count while waiting: ");
+  Serial.println(work);
+  Serial.println();
+
+
+  //-------------TEST 5-------------//
+  //*******Combined Single Byte Writes*******/
+  Serial.println("---Test 5: Combined bytes---");
+
+  i2cMaster_Init(FRAM_ADR_1);
+  FRAM_Word_Adr(1);           // 1 for 16-bit word address type
+  FRAM_Write_Combined(0x01, 'F');
+  FRAM_Write_Combined(0x02, 'R');
+  FRAM_Write_Combined(0x03, 'A');
+  FRAM_Write_Combined(0x04, 'M');
+  char c3 = FRAM_Read_Combined(0x02);   // From buffer, no bus access
+  FRAM_Combine_Flush();                 // 4 bytes in one transaction
+  FRAM_Read_Array(0x01, data, 4);
+  i2cMaster_Disable();
+
+  Serial.print("Char: ");
+  Serial.println(c3);
+  Serial.print("Print Array: ");
+  Serial.println(data);
+  Serial.print("Bytes/Transactions: ");
+  Serial.print(Combine_Bytes);
+  Serial.print("/");
+  Serial.println(Combine_Flushes);
+  Serial.println();
+
+
+  //-------------TEST 6-------------//
+  //*******Binary Buffer over 255 bytes*******/
+  Serial.println("---Test 6: Binary buffer---");
+
+  uint16_t bad = 0;
+  for (uint16_t i = 0; i < sizeof(test_buf.blk); i++) {
+    test_buf.blk[i] = (uint8_t)i;      // Contains '\0' bytes
+  }
+
+  i2cMaster_Init(FRAM_ADR_1);
+  FRAM_Word_Adr(1);           // 1 for 16-bit word address type
+  bool wr_ok = FRAM_Write_Buffer(0x200, test_buf.blk, sizeof(test_buf.blk));
+  memset(test_buf.blk, 0xFF, sizeof(test_buf.blk));
+  bool rd_ok = FRAM_Read_Buffer(0x200, test_buf.blk, sizeof(test_buf.blk));
+  i2cMaster_Disable();
+
+  for (uint16_t i = 0; i < sizeof(test_buf.blk); i++) {
+    if (test_buf.blk[i] != (uint8_t)i) bad++;
+  }
+  Serial.print("Write/Read: ");
+  Serial.print(wr_ok ? "OK" : "FAIL");
+  Serial.print("/");
+  Serial.println(rd_ok ? "OK" : "FAIL");
+  Serial.print("Bad bytes: ");
+  Serial.println(bad);
+  Serial.println();
+
+
+  //-------------TEST 7-------------//
+  //*******Three Devices with Handles, 16-bit and 8-bit word address*******/
+  Serial.println("---Test 7: Device handles---");
+
+  i2cMaster_Bus_Init();       // Once, no slave address
+  FramDevice fram1 = FRAM_Device(FRAM_ADR_1, 1, MB85RC256V_SIZE);
+  FramDevice fram2 = FRAM_Device(FRAM_ADR_2, 1, MB85RC256V_SIZE);
+  FramDevice fram3 = FRAM_Device(FRAM_ADR_3, 0, FM24CL04B_SIZE);
+  FRAM_Write(fram1, 0x160, '1');
+  FRAM_Write(fram2, 0x160, '2');
+  FRAM_Write(fram3, 0x160, '3');      // Page 1 -> slave address 0x55
+  char d1 = FRAM_Read(fram1, 0x160);
+  char d2 = FRAM_Read(fram2, 0x160);
+  char d3 = FRAM_Read(fram3, 0x160);
+
+  Serial.print("FRAM1/FRAM2/FRAM3: ");
+  Serial.print(d1);
+  Serial.print("/");
+  Serial.print(d2);
+  Serial.print("/");
+  Serial.println(d3);
+  Serial.println();
+
+
+  //-------------TEST 8-------------//
+  //*******Streaming Read Cursor*******/
+  Serial.println("---Test 8: Read cursor---");
+
+  char seq[] = "SEQUENTIAL!";
+  char scan[sizeof(seq)];
+  FRAM_Write_Buffer(fram1, 0x80, seq, sizeof(seq));   // With '\0'
+
+  FramCursor cur;
+  FRAM_Cursor_Open(cur, fram1, 0x80);
+  uint8_t n = 0;
+  do {
+    scan[n] = FRAM_Cursor_Read(cur);    // One byte per call, no address sent
+  } while (scan[n++] != '\0' && n < sizeof(scan));
+  FRAM_Cursor_Close(cur);
+
+  Serial.print("Scan: ");
+  Serial.println(scan);
+  Serial.println();
+
+
+  //-------------TEST 9-------------//
+  //*******Cached Counter*******/
+  Serial.println("---Test 9: Line cache---");
+
+  FRAM_Cache_Write(fram1, 0xA0, 0);
+  for (uint8_t i = 0; i < 100; i++) {
+    // Read-modify-write in RAM, no bus access after first miss
+    FRAM_Cache_Write(fram1, 0xA0, FRAM_Cache_Read(fram1, 0xA0) + 1);
+  }
+  FRAM_Cache_Flush();
+  uint8_t count = FRAM_Read(fram1, 0xA0);
+
+  Serial.print("Counter: ");
+  Serial.println(count);
+  Serial.print("Hits/Misses/Writebacks: ");
+  Serial.print(Cache_Hits);
+  Serial.print("/");
+  Serial.print(Cache_Misses);
+  Serial.print("/");
+  Serial.println(Cache_Writebacks);
+  Serial.println();
+
+
+  //-------------TEST 10-------------//
+  //*******Sequential Read-Ahead*******/
+  Serial.println("---Test 10: Read-ahead---");
+
+  char text[sizeof(seq)];
+  for (uint8_t i = 0; i < sizeof(seq); i++) {
+    text[i] = FRAM_Read_Ahead(fram1, 0x80 + i);   // String of Test 8
+  }
+
+  Serial.print("Text: ");
+  Serial.println(text);
+  Serial.print("Hit rate: ");
+  Serial.print(FRAM_Prefetch_Hit_Rate());
+  Serial.println("%");
+  Serial.println();
+
+
+  //-------------TEST 11-------------//
+  //*******Ring-Buffer Log*******/
+  Serial.println("---Test 11: Ring log---");
+
+  FramLog log;
+  FRAM_Log_Begin(log, fram1, 0x1000, 128, 8);   // 9 slots of 8 + 4 bytes
+  FRAM_Log_Format(log);
+  char sample[8] = "SAMPLE0";
+  for (uint8_t i = 0; i < 12; i++) {
+    sample[6] = '0' + (i % 10);
+    FRAM_Log_Append(log, sample);
+  }
+
+  // Reboot: head pointer is recovered without scanning
+  FramLog boot;
+  bool found = FRAM_Log_Begin(boot, fram1, 0x1000, 128, 8);
+  uint32_t first_seq = 0, last_seq = 0;
+  FRAM_Log_Read(boot, 0, sample, &first_seq);
+  FRAM_Log_Read(boot, FRAM_Log_Count(boot) - 1, sample, &last_seq);
+
+  Serial.print("Found/Records: ");
+  Serial.print(found);
+  Serial.print("/");
+  Serial.println(FRAM_Log_Count(boot));
+  Serial.print("Seq oldest/newest: ");
+  Serial.print(first_seq);
+  Serial.print("/");
+  Serial.println(last_seq);
+  Serial.print("Newest: ");
+  Serial.println(sample);
+  Serial.println();
+
+
+  //-------------TEST 12-------------//
+  //*******Key-Value Store*******/
+  Serial.println("---Test 12: Key-value store---");
+
+  FramKV kv;
+  FRAM_KV_Begin(kv, fram1, 0x2000, 512, 16);    // 16 buckets
+  FRAM_KV_Format(kv);
+  FRAM_KV_Put(kv, "name", "FRAM", 5);           // String key, with '\0'
+  uint16_t boots = 41;
+  FRAM_KV_Put(kv, 1000UL, &boots, sizeof(boots));   // Integer key
+  boots++;
+  FRAM_KV_Put(kv, 1000UL, &boots, sizeof(boots));   // Rewritten in place
+
+  char name[8] = "";
+  uint16_t value = 0;
+  FRAM_KV_Get(kv, "name", name, sizeof(name));
+  FRAM_KV_Get(kv, 1000UL, &value, sizeof(value));
+  int16_t missing = FRAM_KV_Get(kv, "none", name, sizeof(name));
+
+  Serial.print("name: ");
+  Serial.println(name);
+  Serial.print("1000: ");
+  Serial.println(value);
+  Serial.print("none: ");
+  Serial.println(missing);
+  Serial.println();
+
+
+  //-------------TEST 13-------------//
+  //*******Typed Read/Write*******/
+  Serial.println("---Test 13: Typed struct---");
+
+  Settings saved = {0, -300, 1.25};     // Zero bytes inside
+  Settings loaded = {0, 0, 0};
+  FRAM_Put(fram1, 0x300, saved);
+  FRAM_Get(fram1, 0x300, loaded);
+
+  Serial.print("mode/offset/gain: ");
+  Serial.print(loaded.mode);
+  Serial.print("/");
+  Serial.print(loaded.offset);
+  Serial.print("/");
+  Serial.println(loaded.gain);
+  Serial.println();
+
+
+  //-------------TEST 14-------------//
+  //*******Compile-Time Device*******/
+  Serial.println("---Test 14: Compile-time device---");
+
+  Fram1::Write<0x7FFF>('Z');            // Last byte, checked at compile time
+  //Fram1::Write<0x8000>('Z');          // Does not compile, beyond 32 KB
+  Fram1::Put<0x310>(saved);
+  char z = FRAM_Read(fram1, 0x7FFF);    // Same chip through FramDevice
+  Settings typed = {0, 0, 0};
+  Fram1::Get(0x310, typed);
+
+  Serial.print("Last byte: ");
+  Serial.println(z);
+  Serial.print("offset: ");
+  Serial.println(typed.offset);
+  Serial.println();
+
+
+  //-------------TEST 15-------------//
+  //*******FRAM Stream*******/
+  Serial.println(F("---Test 15: Stream---"));
+
+  static FramStream out(fram1, 0x4000, 256);    // Static, buffer is not on the stack
+  out.print(F("Temp: "));               // Buffered, no bus access yet
+  out.println(23.5);
+  out.print(F("Count: "));
+  out.println(async_done);
+  out.flush();                          // One sequential write
+
+  out.seek(0);
+  size_t len = out.available();         // Not more than available, readBytes() would wait
+  if (len > sizeof(test_buf.line) - 1) len = sizeof(test_buf.line) - 1;
+  len = out.readBytes(test_buf.line, len);
+  test_buf.line[len] = '\0';
+
+  Serial.print(test_buf.line);
+  Serial.println();
+
+
+  //-------------TEST 16-------------//
+  //*******Bus Trace*******/
+  Serial.println(F("---Test 16: Bus trace---"));
+
+#ifdef I2C_TRACE
+  FramDevice absent = FRAM_Device(0x57, 1, MB85RC256V_SIZE);
+  FRAM_Read(absent, 0x0000);            // No ACK -> MTX_ADR_not_reach
+  i2cTrace_Dump_CSV(Serial);
+#else
+  Serial.println(F("I2C_TRACE not defined"));
+#endif
+  Serial.println();
+
+
+  //-------------TEST 17-------------//
+  //*******Bus Recovery*******/
+  Serial.println(F("---Test 17: Bus recovery---"));
+
+  bool bus_free = i2cMaster_Bus_Recover();    // Also runs after dead-loop errors
+  Serial.print(F("Bus free/stuck/pulses: "));
+  Serial.print(bus_free);
+  Serial.print('/');
+  Serial.print(I2C_Recovery.stuck);
+  Serial.print('/');
+  Serial.println(I2C_Recovery.pulses);
+  Serial.print(F("Read after recovery: "));
+  Serial.println(FRAM_Read(fram1, 0x4000));  // First byte of Test 15 stream
+  Serial.println();
+
+
+  //-------------TEST 18-------------//
+  //*******Write Pipeline*******/
+  Serial.println(F("---Test 18: Write pipeline---"));
+
+  static FramPipe pipe;
+  FRAM_Pipe_Begin(pipe, fram1, 0x5000, 80);    // Ring of 80 bytes
+  for (uint8_t i = 0; i < 100; i++) {
+    while (!FRAM_Pipe_Write(pipe, i)) {}       // Sample, wait on backpressure
+  }
+  bool synced = FRAM_Pipe_Sync(pipe);
+
+  FRAM_Read_Buffer(fram1, 0x5000, test_buf.ring, sizeof(test_buf.ring));
+  bool match = 1;
+  for (uint8_t j = 0; j < sizeof(test_buf.ring); j++) {
+    match &= (test_buf.ring[j] == ((j < 20) ? j + 80 : j));    // 100 samples wrapped once
+  }
+  Serial.print(F("Synced/verify: "));
+  Serial.print(synced);
+  Serial.print('/');
+  if (match) Serial.println(F("OK"));
+  else Serial.println(F("FAIL"));
+  Serial.print(F("Stalls: "));
+  Serial.println(pipe.stalls > 0);
+  Serial.println();
+
+
+  //-------------TEST 19-------------//
+  //*******Volume over Two Chips*******/
+  Serial.println(F("---Test 19: Volume over two chips---"));
+
+  FramDevice chips[2] = {fram1, fram2};
+  FramVolume vol;
+  FRAM_Volume_Begin(vol, chips, 2);             // 64 KB, fram2 starts at 0x8000
+  const char span[] = "ACROSS-CHIPS";
+  FRAM_Volume_Write(vol, 0x7FFA, span, sizeof(span));   // 6 bytes each chip
+  char joined[sizeof(span)];
+  FRAM_Volume_Read(vol, 0x7FFA, joined, sizeof(joined));
+  Serial.print(F("Size: "));
+  Serial.println(FRAM_Volume_Size(vol));
+  Serial.print(F("Text: "));
+  Serial.println(joined);
+  Serial.print(F("fram2 0x0000: "));
+  Serial.println(FRAM_Read(fram2, 0x0000));
+  Serial.println();
+
+
+  //-------------TEST 20-------------//
+  //*******Mirrored Pair*******/
+  Serial.println(F("---Test 20: Mirrored pair---"));
+
+  static FramMirror mirror;
+  FRAM_Mirror_Begin(mirror, fram1, fram2, 0x6000, 256, 8);   // 8-byte blocks + check
+  FRAM_Mirror_Write(mirror, 2, "MIRROR!");
+  FRAM_Mirror_Write(mirror, 5, "RESYNC!");
+  FRAM_Write(fram1, 0x6000 + 2 * 10, 'X');      // Damage block 2 on primary
+  FRAM_Write(fram2, 0x6000 + 5 * 10, 'Y');      // Damage block 5 on secondary
+
+  char block[8];
+  bool got = FRAM_Mirror_Read(mirror, 2, block);   // Served by secondary, primary repaired
+  Serial.print(F("Block 2: "));
+  if (got) Serial.println(block);
+  else Serial.println(F("none"));
+  Serial.print(F("Fallbacks: "));
+  Serial.println(mirror.fallbacks);
+  Serial.print(F("Resync repaired: "));
+  Serial.println(FRAM_Mirror_Resync(mirror));
+  Serial.print(F("Secondary block 5: "));
+  Serial.println(FRAM_Read(fram2, 0x6000 + 5 * 10));
+  Serial.println();
+
+
+  //-------------TEST 21-------------//
+  //*******CRC during Transfer*******/
+  Serial.println(F("---Test 21: CRC during transfer---"));
+
+  const char check[] = "123456789";             // Standard check string
+  Serial.print(F("CRC-16/CRC-32: "));
+  Serial.print(FRAM_CRC<FramCRC16>(check, 9), HEX);    // 29B1
+  Serial.print('/');
+  Serial.println(FRAM_CRC<FramCRC32>(check, 9), HEX);  // CBF43926
+
+  for (uint8_t i = 0; i < sizeof(test_buf.stored); i++) test_buf.stored[i] = i * 7;
+  FRAM_Write_Block_CRC<FramCRC32>(fram1, 0x7000, test_buf.stored, sizeof(test_buf.stored));   // 104 bytes, one write
+  bool intact = FRAM_Read_Block_CRC<FramCRC32>(fram1, 0x7000, test_buf.stored, sizeof(test_buf.stored));
+  FRAM_Write(fram1, 0x7010, 0xEE);              // Damage one byte
+  bool damaged = !FRAM_Read_Block_CRC<FramCRC32>(fram1, 0x7000, test_buf.stored, sizeof(test_buf.stored));
+
+  uint16_t crc16 = FramCRC16::init;             // Streaming, two parts
+  FRAM_Read_Buffer_CRC<FramCRC16>(fram1, 0x7000, test_buf.stored, 50, crc16);
+  FRAM_Read_Buffer_CRC<FramCRC16>(fram1, 0x7032, test_buf.stored + 50, 50, crc16);
+  bool stream = (FramCRC16::Final(crc16) == FRAM_CRC<FramCRC16>(test_buf.stored, sizeof(test_buf.stored)));
+
+  Serial.print(F("Intact/damaged/stream: "));
+  Serial.print(intact);
+  Serial.print('/');
+  Serial.print(damaged);
+  Serial.print('/');
+  Serial.println(stream);
+  i2cMaster_Disable();
+  Serial.println();
   Serial.println("+++End Test+++");
 }
 
@@ -123,4 +617,4 @@ void loop() {
 
 }
 
-
+
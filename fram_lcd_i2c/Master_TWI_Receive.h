@@ -16,6 +16,9 @@
 
 */
 
+#ifndef MASTER_TWI_RECEIVE_H
+#define MASTER_TWI_RECEIVE_H
+
 #include "Master_TWI.h"
 
 //=====================================================//
@@ -59,25 +62,22 @@
 void i2cMaster_Repeat(void)
 {
   /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
+  if (MasterTX_RX_Error > 0) return;
 
   TWCR = (1 << TWEN)  |    // TWI enabled
          (1 << TWINT) |    // Enable TWI interrupt flag
          (1 << TWSTA);     // Enable START bit to transmit
+  I2C_STAT(repeat);
 
   // Check and wait REPEAT condition is transmitted
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      // Serial.println("Break");
-      MasterTX_RX_Error = MRX_REPEAT_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(I2C_STAGE_REPEAT))
+  { // If wait condition exceeded, then break
+    // Serial.println("Break");
+    MasterTX_RX_Error = MRX_REPEAT_dead_loop;
+    MTX_RX_ERROR();
+    return;
   }
   //---------------------------------------------------------------//
 
@@ -85,7 +85,7 @@ void i2cMaster_Repeat(void)
   if ((TWSR & 0xF8) != TWI_REP_START) {
     MasterTX_RX_Error = MRX_REPEAT_not_reach;
     MTX_RX_ERROR();
-    return 0;
+    return;
   }
   else {
     MasterTX_RX_Error = 0;     // No error
@@ -101,25 +101,22 @@ void i2cMaster_Repeat(void)
 void i2cMaster_Adr_Read(unsigned char Addr)
 {
   /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
+  if (MasterTX_RX_Error > 0) return;
 
   TWDR = Addr;            // Load address into TWDR register
   TWCR = (1 << TWINT) |   // Clear TWINT to start transmission
          (1 << TWEN);
+  I2C_STAT(bytes);
 
   // Check and wait SLA+R is transmitted and ACK is received
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      //      Serial.println("Break");
-      MasterTX_RX_Error = MRX_ADR_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(I2C_STAGE_SLA))
+  { // If wait condition exceeded, then break
+    //      Serial.println("Break");
+    MasterTX_RX_Error = MRX_ADR_dead_loop;
+    MTX_RX_ERROR();
+    return;
   }
   //---------------------------------------------------------------//
 
@@ -127,7 +124,7 @@ void i2cMaster_Adr_Read(unsigned char Addr)
   if ((TWSR & 0xF8) != TWI_MRX_ADR_ACK) {
     MasterTX_RX_Error = MRX_ADR_not_reach;
     MTX_RX_ERROR();
-    return 0;
+    return;
   }
   else {
     MasterTX_RX_Error = 0;     // No error
@@ -135,35 +132,40 @@ void i2cMaster_Adr_Read(unsigned char Addr)
   //  Serial.println("read adr");
 }
 
-//5. Receive Data (can be repeated)
-char i2cMaster_Data_Read(void)
+//5a. Start receiving data, returns while byte is shifting
+// ack = 1: ACK return (more bytes follow), ack = 0: NACK (last byte)
+void i2cMaster_Data_Read_Begin(bool ack)
 {
   /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
+  if (MasterTX_RX_Error > 0) return;
 
   TWCR = (1 << TWINT) |   // Clear TWINT to start transmission
          (1 << TWEN)  |
-         (1 << TWEA);     // Read ACK return
+         (ack ? (1 << TWEA) : 0);   // Read ACK return
+  I2C_STAT(bytes);
+}
+
+//5b. Wait data is received, same ack as i2cMaster_Data_Read_Begin()
+char i2cMaster_Data_Read_End(bool ack)
+{
+  /*** If there is error code, then out of the loop ***/
+  if (MasterTX_RX_Error > 0) return 0;
 
   // Check and wait DATA is received and ACK is return
   // Avoid while dead-loop by BREAKING after the specified time
   //---------------------------------------------------------------//
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      // Serial.println("Break");
-      MasterTX_RX_Error = MRX_DATA_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
+  if (!i2cMaster_Wait_TWINT(ack ? I2C_STAGE_DATA : I2C_STAGE_DATA_N))
+  { // If wait condition exceeded, then break
+    // Serial.println("Break");
+    MasterTX_RX_Error = ack ? MRX_DATA_dead_loop : MRX_DATA_N_dead_loop;
+    MTX_RX_ERROR();
+    return 0;
   }
   //---------------------------------------------------------------//
 
   // Check code and error detection for ADR_ACK
-  if ((TWSR & 0xF8) != TWI_MRX_DATA_ACK) {
-    MasterTX_RX_Error = MRX_DATA_not_reach;
+  if ((TWSR & 0xF8) != (ack ? TWI_MRX_DATA_ACK : TWI_MRX_DATA_NACK)) {
+    MasterTX_RX_Error = ack ? MRX_DATA_not_reach : MRX_DATA_N_not_reach;
     MTX_RX_ERROR();
     return 0;
   }
@@ -176,38 +178,19 @@ char i2cMaster_Data_Read(void)
   return data;
 }
 
-
-//6. Receive Data NACK - end of received data
-void i2cMaster_Data_Read_N(void)
+//5. Receive Data (can be repeated)
+char i2cMaster_Data_Read(void)
 {
-  /*** If there is error code, then out of the loop ***/
-  if (MasterTX_RX_Error > 0) return 0;
-
-  TWCR = (1 << TWINT) |   // Clear TWINT to start transmission
-         (1 << TWEN);
+  i2cMaster_Data_Read_Begin(1);
+  return i2cMaster_Data_Read_End(1);
+}
 
-  // Check and wait DATA is received and ACK is return
-  // Avoid while dead-loop by BREAKING after the specified time
-  Current_Sec = Ref_Sec;
-  while (!(TWCR & (1 << TWINT)))
-  {
-    if (Ref_Sec - Current_Sec > Wait_Sec)
-    { // If wait condition exceeded, then break this while loop
-      MasterTX_RX_Error = MRX_DATA_N_dead_loop;
-      MTX_RX_ERROR();
-      return 0;
-    }
-  }
-  //---------------------------------------------------------------//
 
-  // Check code and error detection for ADR_ACK
-  if ((TWSR & 0xF8) != TWI_MRX_DATA_NACK) {
-    MasterTX_RX_Error = MRX_DATA_N_not_reach;
-    MTX_RX_ERROR();
-    return 0;
-  }
-  else {
-    MasterTX_RX_Error = 0;     // No error
-  }
+//6. Receive Data NACK - end of received data
+char i2cMaster_Data_Read_N(void)
+{
+  i2cMaster_Data_Read_Begin(0);
+  return i2cMaster_Data_Read_End(0);   // Last byte, received with NACK
 }
-
+
+#endif
@@ -13,8 +13,8 @@
     **Notes - Don't forget to check MCU clock if another Arduino board is used.**
     **        (e.g. Pro Mini 3.3v, 8MHz)                                       **
     *****************************************************************************
-    **Caution - If Mega board is used, don't forget to uncomment and comment   **
-    **          ports at i2cMaster_Init() in "Master_TWI.h" header.            **
+    **Caution - I2C pins are selected from board MCU (UNO/Nano, Mega,         **
+    **          Leonardo). For other MCUs, see "Master_TWI.h" header.          **
     *****************************************************************************
     !!UPDATED: - Additional function that terminate I2C communication protocol.
                  "i2cMaster_Disable()"
@@ -23,6 +23,9 @@
                  n = 0 -> 8-bit word address (Default)
                  n = 1 -> 16-bit word address
 
+    !!UPDATED: - FRAM device handles, loop() switches between FRAM1 and FRAM2
+                 without re-initializing I2C bus.
+
     Date: 30 Sep 2019
 
     Written By
@@ -40,6 +43,8 @@
 LiquidCrystal_I2C lcd(0x27, 16, 2);
 
 uint8_t num = 0x00;
+FramDevice fram1;
+FramDevice fram2;
 
 void setup() {
   // initialize the LCD
@@ -143,20 +148,19 @@ void setup() {
   lcd.setCursor(0, 1);
   lcd.print("FRAM2 = ");
 
+  // Bus is initialized once, devices are selected per call
+  i2cMaster_Bus_Init();
+  fram1 = FRAM_Device(FRAM_ADR_1, 1, MB85RC256V_SIZE);
+  fram2 = FRAM_Device(FRAM_ADR_2, 1, MB85RC256V_SIZE);
+
 }
 
 void loop() {
-  i2cMaster_Init(FRAM_ADR_1);
-  FRAM_Word_Adr(1);
-  FRAM_Write(num, num);
-  unsigned char c2 = FRAM_Read(num);
-  //  i2cMaster_Disable();
+  FRAM_Write(fram1, num, num);
+  unsigned char c2 = FRAM_Read(fram1, num);
 
-  i2cMaster_Init(FRAM_ADR_2);
-  FRAM_Word_Adr(1);
-  FRAM_Write(num, num);
-  unsigned char c3 = FRAM_Read(num);
-  //  i2cMaster_Disable();
+  FRAM_Write(fram2, num, num);
+  unsigned char c3 = FRAM_Read(fram2, num);
 
   Serial.print(c2);
   Serial.print("      ");
@@ -173,4 +177,4 @@ void loop() {
 
 }
 
-
+
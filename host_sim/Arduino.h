@@ -0,0 +1,172 @@
+/*
+    Host Arduino Core
+    -----------------
+    Header file name - "Arduino.h"
+    Must include: "sim_twi.h"
+
+    Description:
+    Minimal Arduino/AVR core for host builds. Only what the FRAM driver
+    headers and example sketches use is provided: AVR integer types, TWI,
+    port and Timer1 registers (backed by the simulator), millis()/micros()/
+    delay(), interrupt control and a Serial port printing to stdout.
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+
+#include "sim_twi.h"
+
+#ifndef F_CPU
+#define F_CPU   16000000UL
+#endif
+
+typedef uint8_t byte;
+typedef bool boolean;
+
+#define HIGH    0x1
+#define LOW     0x0
+#define DEC     10
+#define HEX     16
+#define OCT     8
+#define BIN     2
+
+#define F(str)              (str)
+#define PROGMEM
+#define pgm_read_byte(p)    (*(const uint8_t*)(p))
+#define pgm_read_word(p)    (*(const uint16_t*)(p))
+#define pgm_read_dword(p)   (*(const uint32_t*)(p))
+
+//**************** TWI Registers ******************//
+extern SimTwiReg TWCR;
+extern SimTwiReg TWSR;
+extern SimTwiReg TWDR;
+extern SimTwiReg TWBR;
+
+// TWCR bits
+#define TWINT   7
+#define TWEA    6
+#define TWSTA   5
+#define TWSTO   4
+#define TWWC    3
+#define TWEN    2
+#define TWIE    0
+
+// TWSR bits
+#define TWPS1   1
+#define TWPS0   0
+
+//**************** Port Registers ******************//
+extern SimPortReg DDRC, PORTC, PINC;
+extern volatile uint8_t DDRD, PORTD, PIND;
+
+#define DDC4    4
+#define DDC5    5
+#define PC4     4
+#define PC5     5
+#define PINC4   4
+#define PINC5   5
+#define DDD0    0
+#define DDD1    1
+#define PD0     0
+#define PD1     1
+#define PIND0   0
+#define PIND1   1
+
+//**************** Timer1 Registers ******************//
+extern volatile uint8_t TCCR1A, TCCR1B;
+extern SimTimer16 TCNT1;
+
+#define CS10    0
+#define CS11    1
+#define CS12    2
+
+//**************** Interrupts ******************//
+class SimSreg {
+  public:
+    operator uint8_t() const { return sim_irq_enabled() ? 0x80 : 0x00; }
+    SimSreg& operator=(uint8_t value) { sim_set_irq(value & 0x80); return *this; }
+};
+extern SimSreg SREG;
+
+#define cli()   sim_set_irq(false)
+#define sei()   sim_set_irq(true)
+
+// ISR(TWI_vect) defines the handler the simulator dispatches on TWINT
+#define TWI_vect            sim_vector_TWI
+#define ISR(vector, ...)    extern "C" void vector(void)
+
+//**************** Time ******************//
+unsigned long millis(void);
+unsigned long micros(void);
+void delay(unsigned long ms);
+void delayMicroseconds(unsigned int us);
+
+//**************** Print / Stream ******************//
+class Print {
+  public:
+    Print() : write_error_(0) {}
+    virtual ~Print() {}
+    int getWriteError() { return write_error_; }
+    void clearWriteError() { setWriteError(0); }
+    virtual size_t write(uint8_t c) = 0;
+    virtual size_t write(const uint8_t* buffer, size_t size);
+    size_t write(const char* str) { return str ? write((const uint8_t*)str, strlen(str)) : 0; }
+    virtual void flush() {}
+
+    size_t print(const char* str) { return write(str); }
+    size_t print(char c) { return write((uint8_t)c); }
+    size_t print(unsigned char n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(int n, int base = DEC) { return print((long)n, base); }
+    size_t print(unsigned int n, int base = DEC) { return print((unsigned long)n, base); }
+    size_t print(long n, int base = DEC);
+    size_t print(unsigned long n, int base = DEC);
+    size_t print(double n, int digits = 2);
+
+    size_t println(void) { return write("\r\n"); }
+    template <typename T> size_t println(T value) { size_t n = print(value); return n + println(); }
+    template <typename T> size_t println(T value, int fmt) { size_t n = print(value, fmt); return n + println(); }
+
+  protected:
+    void setWriteError(int err = 1) { write_error_ = err; }
+
+  private:
+    int write_error_;
+};
+
+class Stream : public Print {
+  public:
+    virtual int available() = 0;
+    virtual int read() = 0;
+    virtual int peek() = 0;
+    size_t readBytes(char* buffer, size_t length);
+    size_t readBytes(uint8_t* buffer, size_t length) { return readBytes((char*)buffer, length); }
+};
+
+class HardwareSerial : public Stream {
+  public:
+    void begin(unsigned long baud) { (void)baud; }
+    void end() {}
+    operator bool() const { return true; }
+    int available() { return 0; }
+    int read() { return -1; }
+    int peek() { return -1; }
+    size_t write(uint8_t c);
+    size_t write(const uint8_t* buffer, size_t size);
+    using Print::write;
+    void flush();
+};
+extern HardwareSerial Serial;
+
+//**************** Sketch Entry ******************//
+void setup(void);
+void loop(void);
+
+#endif
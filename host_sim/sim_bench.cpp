@@ -0,0 +1,243 @@
+/*
+    Host Bus Cycle Benchmark
+    ------------------------
+    Source file name - "sim_bench.cpp"
+
+    Description:
+    Runs each driver operation once on the simulated bus and reports what it
+    cost: START/REPEAT/STOP conditions, address and data bytes on the wire,
+    bus time in SCL periods and total CPU cycles (bus time plus driver
+    overhead such as polling and ready gating).
+    Both device types are measured: MB85RC256V (16-bit word address) and
+    FM24CL16B (8-bit word address).
+    Last row writes and reads back the first FULL_LEN bytes in one
+    transaction per direction. Functions without device argument send no
+    page bits, on FM24CL16B this relies on the chip rolling over into the
+    next page. FM24CL16B is measured again through a device handle with
+    capacity: page bits in slave address, one transaction per 256-byte page.
+    Bus recovery is measured against a slave holding SDA low for a number
+    of SCL clocks (sim_hold_sda()), below and above I2C_RECOVER_PULSES.
+
+    Date: 17 Oct 2026
+*/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+#include "Fram_Rx_Tx_Operation.h"
+#include "Fram_Write_Combine.h"
+#include "Fram_Prefetch.h"
+#include "Fram_CRC.h"
+
+#define BENCH_ARRAY_LEN   16
+#define BENCH_BUFFER_LEN  256
+#define SCAN_LEN          64        // Bytes of single byte scans
+#define FULL_LEN          2048      // FM24CL16B capacity
+
+static char arr[BENCH_ARRAY_LEN + 1];
+static uint8_t buf[BENCH_BUFFER_LEN];
+static uint8_t full[FULL_LEN];
+
+static SimBusStats before;
+static uint64_t before_cycles;
+
+static void bench_begin(void)
+{
+  before = sim_bus_stats();
+  before_cycles = sim_cycles();
+}
+
+static void bench_end(const char* name, uint16_t payload)
+{
+  const SimBusStats& s = sim_bus_stats();
+  uint64_t cycles = sim_cycles() - before_cycles;
+
+  printf("%-24s %7u %5u %5u %5u %6u %8llu %9llu %8.1f\n", name, payload,
+         (s.starts - before.starts) + (s.rep_starts - before.rep_starts),
+         s.stops - before.stops,
+         s.sla_bytes - before.sla_bytes,
+         s.data_bytes - before.data_bytes,
+         (unsigned long long)(s.scl_periods - before.scl_periods),
+         (unsigned long long)cycles,
+         payload ? (double)cycles / payload : 0.0);
+}
+
+static void bench_device(const char* title, SimFramType type, bool adr_type)
+{
+  sim_detach_all();
+  sim_attach_fram(type, 0x50);
+  i2cMaster_Init(0x50);
+  FRAM_Word_Adr(adr_type);
+
+  printf("\n%s\n", title);
+  printf("%-24s %7s %5s %5s %5s %6s %8s %9s %8s\n", "operation", "payload",
+         "start", "stop", "sla", "data", "scl", "cycles", "cyc/byte");
+
+  bench_begin();
+  FRAM_Write(0x10, 'A');
+  bench_end("FRAM_Write", 1);
+
+  bench_begin();
+  FRAM_Read(0x10);
+  bench_end("FRAM_Read", 1);
+
+  bench_begin();
+  FRAM_Write_Array(0x20, arr);
+  bench_end("FRAM_Write_Array", BENCH_ARRAY_LEN);
+
+  bench_begin();
+  FRAM_Read_Array(0x20, arr, BENCH_ARRAY_LEN);
+  bench_end("FRAM_Read_Array", BENCH_ARRAY_LEN);
+
+  bench_begin();
+  for (uint8_t i = 0; i < SCAN_LEN; i++) {
+    FRAM_Read(0x40 + i);
+  }
+  bench_end("FRAM_Read x64 sequential", SCAN_LEN);
+
+  FRAM_Prefetch_Invalidate();
+  bench_begin();
+  for (uint8_t i = 0; i < SCAN_LEN; i++) {
+    FRAM_Read_Ahead(0x40 + i);
+  }
+  bench_end("FRAM_Read_Ahead x64", SCAN_LEN);
+
+  FramDevice dev = FRAM_Default_Device();
+  FramCursor cur;
+  bench_begin();
+  FRAM_Cursor_Open(cur, dev, 0x40);
+  FRAM_Cursor_Read(cur, buf, BENCH_ARRAY_LEN);
+  FRAM_Cursor_Close(cur);
+  bench_end("FRAM_Cursor_Read x16", BENCH_ARRAY_LEN);
+
+  bench_begin();
+  FRAM_Write_Buffer(0x00, buf, BENCH_BUFFER_LEN);
+  bench_end("FRAM_Write_Buffer", BENCH_BUFFER_LEN);
+
+  bench_begin();
+  FRAM_Read_Buffer(0x00, buf, BENCH_BUFFER_LEN);
+  bench_end("FRAM_Read_Buffer", BENCH_BUFFER_LEN);
+
+  bench_begin();
+  FRAM_Write_Block_CRC<FramCRC32>(dev, 0x00, buf, BENCH_BUFFER_LEN);
+  bench_end("FRAM_Write_Block_CRC32", BENCH_BUFFER_LEN);
+
+  bench_begin();
+  bool crc_ok = FRAM_Read_Block_CRC<FramCRC32>(dev, 0x00, buf, BENCH_BUFFER_LEN);
+  bench_end(crc_ok ? "FRAM_Read_Block_CRC32" : "FRAM_Read_Block_CRC32 FAIL", BENCH_BUFFER_LEN);
+
+  bench_begin();
+  for (uint8_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+    FRAM_Write(0x30 + i, arr[i]);
+  }
+  bench_end("FRAM_Write x16", BENCH_ARRAY_LEN);
+
+  bench_begin();
+  for (uint8_t i = 0; i < BENCH_ARRAY_LEN; i++) {
+    FRAM_Write_Combined(0x30 + i, arr[i]);
+  }
+  FRAM_Combine_Flush();
+  bench_end("FRAM_Write_Combined x16", BENCH_ARRAY_LEN);
+
+  for (uint16_t i = 0; i < FULL_LEN; i++) full[i] = (uint8_t)(i ^ (i >> 8));
+  bench_begin();
+  FRAM_Write_Buffer(0x00, full, FULL_LEN);
+  FRAM_Read_Buffer(0x00, full, FULL_LEN);
+  bench_end("Write+Read 2048", FULL_LEN * 2);
+
+  uint16_t bad = 0;
+  for (uint16_t i = 0; i < FULL_LEN; i++) {
+    if (full[i] != (uint8_t)(i ^ (i >> 8))) bad++;
+  }
+  printf("%-24s %s\n", "verify 2048", bad ? "FAIL" : "OK");
+}
+
+// FM24CL16B handle with capacity, page bits A8..A10 in slave address
+static void bench_pages(void)
+{
+  sim_detach_all();
+  sim_attach_fram(SIM_FM24CL16B, 0x50);
+  i2cMaster_Bus_Init();
+  FRAM_Latch_Invalidate();
+  FramDevice dev = FRAM_Device(0x50, 0, FM24CL16B_SIZE);
+
+  printf("\nFM24CL16B device handle (page bits in slave address)\n");
+  printf("%-24s %7s %5s %5s %5s %6s %8s %9s %8s\n", "operation", "payload",
+         "start", "stop", "sla", "data", "scl", "cycles", "cyc/byte");
+
+  for (uint16_t i = 0; i < FULL_LEN; i++) full[i] = (uint8_t)(i * 3 + (i >> 8));
+  sim_reset_stats();
+  bench_begin();
+  FRAM_Write_Buffer(dev, 0x00, full, FULL_LEN);
+  bench_end("FRAM_Write_Buffer 2048", FULL_LEN);
+
+  memset(full, 0, FULL_LEN);
+  bench_begin();
+  FRAM_Read_Buffer(dev, 0x00, full, FULL_LEN);
+  bench_end("FRAM_Read_Buffer 2048", FULL_LEN);
+
+  // Slave addresses 0x50..0x57 used, one per page
+  uint8_t pages = 0;
+  for (uint8_t b = 0; b < 8; b++) {
+    if (sim_bus_stats().sla_used[0x50 >> 3] & (1 << b)) pages++;
+  }
+  printf("%-24s %u\n", "slave addresses", pages);
+
+  uint16_t bad = 0;
+  uint8_t* mem = sim_fram_memory(0x50);
+  for (uint16_t i = 0; i < FULL_LEN; i++) {
+    uint8_t v = (uint8_t)(i * 3 + (i >> 8));
+    if (full[i] != v || mem[i] != v) bad++;
+  }
+  printf("%-24s %s\n", "verify 2048", bad ? "FAIL" : "OK");
+}
+
+// Slave holding SDA low, as after a reset in the middle of a read: START
+// runs into its stage timeout, then the driver clocks SCL until SDA is free
+static void bench_recovery(void)
+{
+  static const uint16_t holds[3] = {3, I2C_RECOVER_PULSES, I2C_RECOVER_PULSES + 3};
+
+  sim_detach_all();
+  sim_attach_fram(SIM_MB85RC256V, 0x50);
+  i2cMaster_Init(0x50);
+  FRAM_Word_Adr(1);
+  FRAM_Write(0x10, 'R');
+
+  printf("\nBus recovery (slave holds SDA low)\n");
+  printf("%-24s %5s %6s %6s %6s %9s\n", "hold clocks", "stuck", "pulses", "failed",
+         "read", "cycles");
+
+  for (uint8_t h = 0; h < 3; h++) {
+    I2C_Recovery_t none = {0, 0, 0, 0};
+    I2C_Recovery = none;
+    FRAM_Latch_Invalidate();
+    sim_hold_sda(holds[h]);
+
+    uint64_t start = sim_cycles();
+    FRAM_Read(0x10);                        // START times out, bus is recovered
+    char c = FRAM_Read(0x10);
+    uint64_t cycles = sim_cycles() - start;
+
+    printf("%-24u %5lu %6lu %6lu %6s %9llu\n", holds[h], I2C_Recovery.stuck,
+           I2C_Recovery.pulses, I2C_Recovery.failed, (c == 'R') ? "OK" : "FAIL",
+           (unsigned long long)cycles);
+
+    sim_hold_sda(0);                        // Slave gives up, bus free again
+    i2cMaster_Bus_Recover();
+  }
+}
+
+int main(void)
+{
+  for (uint8_t i = 0; i < BENCH_ARRAY_LEN; i++) arr[i] = 'A' + i;
+  arr[BENCH_ARRAY_LEN] = '\0';
+  for (uint16_t i = 0; i < BENCH_BUFFER_LEN; i++) buf[i] = (uint8_t)i;
+
+  printf("F_CPU %lu Hz, SCL %lu Hz\n", (unsigned long)F_CPU, (unsigned long)i2cMaster_Get_Speed());
+  bench_device("MB85RC256V (16-bit word address)", SIM_MB85RC256V, 1);
+  bench_device("FM24CL16B (8-bit word address)", SIM_FM24CL16B, 0);
+  bench_pages();
+  bench_recovery();
+  return 0;
+}
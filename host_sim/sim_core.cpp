@@ -0,0 +1,88 @@
+/*
+    Host Arduino Core
+    -----------------
+    Source file name - "sim_core.cpp"
+
+    Description:
+    Print/Stream formatting and Serial port (stdout) for host builds.
+
+    Date: 17 Oct 2026
+*/
+
+#include <stdio.h>
+
+#include "Arduino.h"
+
+HardwareSerial Serial;
+
+//**************** Print / Stream ******************//
+size_t Print::write(const uint8_t* buffer, size_t size)
+{
+  size_t n = 0;
+  while (size--) {
+    if (!write(*buffer++)) break;
+    n++;
+  }
+  return n;
+}
+
+size_t Print::print(unsigned long n, int base)
+{
+  char buf[8 * sizeof(long) + 1];
+  char* str = &buf[sizeof(buf) - 1];
+  *str = '\0';
+  if (base < 2) base = 10;
+  do {
+    char c = n % base;
+    n /= base;
+    *--str = c < 10 ? c + '0' : c + 'A' - 10;
+  } while (n);
+  return write(str);
+}
+
+size_t Print::print(long n, int base)
+{
+  if (base == 10 && n < 0) {
+    size_t t = print('-');
+    return t + print((unsigned long)-n, 10);
+  }
+  return print((unsigned long)n, base);
+}
+
+size_t Print::print(double n, int digits)
+{
+  char buf[48];
+  snprintf(buf, sizeof(buf), "%.*f", digits, n);
+  return write(buf);
+}
+
+size_t Stream::readBytes(char* buffer, size_t length)
+{
+  size_t count = 0;
+  while (count < length) {
+    int c = read();
+    if (c < 0) break;
+    *buffer++ = (char)c;
+    count++;
+  }
+  return count;
+}
+
+size_t HardwareSerial::write(uint8_t c)
+{
+  if (c != '\r') putchar(c);
+  return 1;
+}
+
+size_t HardwareSerial::write(const uint8_t* buffer, size_t size)
+{
+  for (size_t i = 0; i < size; i++) {
+    if (buffer[i] != '\r') putchar(buffer[i]);
+  }
+  return size;
+}
+
+void HardwareSerial::flush()
+{
+  fflush(stdout);
+}
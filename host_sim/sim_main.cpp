@@ -0,0 +1,41 @@
+/*
+    Host Sketch Runner
+    ------------------
+    Source file name - "sim_main.cpp"
+
+    Description:
+    Runs an Arduino sketch against the simulated TWI bus. Serial output goes
+    to stdout, devices are attached from the environment before setup().
+
+    Environment:
+      FRAM_SIM_DEVICES - device list (default "mb85rc256v@50,mb85rc256v@51,fm24cl04b@54")
+      FRAM_SIM_LOOPS   - number of loop() calls (default 1)
+
+    Date: 17 Oct 2026
+*/
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "Arduino.h"
+
+//**************** Entry ******************//
+int main(void)
+{
+  const char* spec = getenv("FRAM_SIM_DEVICES");
+  if (!sim_attach_spec(spec ? spec : "mb85rc256v@50,mb85rc256v@51,fm24cl04b@54")) {
+    fprintf(stderr, "sim: bad FRAM_SIM_DEVICES spec\n");
+    return 2;
+  }
+
+  const char* loops_env = getenv("FRAM_SIM_LOOPS");
+  unsigned long loops = loops_env ? strtoul(loops_env, 0, 10) : 1;
+
+  sim_start_irq_timer();
+  setup();
+  for (unsigned long i = 0; i < loops; i++) {
+    loop();
+  }
+  fflush(stdout);
+  return 0;
+}
@@ -0,0 +1,258 @@
+/*
+    Host Driver Checks
+    ------------------
+    Source file name - "sim_test.cpp"
+
+    Description:
+    Driver behaviour which needs the simulator to misbehave or to look
+    inside a device (device not answering, raw chip memory). Every check
+    prints one line "<name> PASS|FAIL", exit code is 1 if one failed.
+    Output is compared by "make check" like the sketches.
+
+    Date: 17 Oct 2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+
+#include "Arduino.h"
+#include "Fram_Rx_Tx_Operation.h"
+#include "Fram_Async_TWI.h"
+#include "Fram_Stream.h"
+#include "Fram_KV.h"
+#include "Fram_Cache.h"
+#include "Fram_Device_Traits.h"
+#include "Fram_CRC.h"
+#include "Fram_Write_Combine.h"
+
+static int failed = 0;
+
+static void check(const char* name, bool ok)
+{
+  printf("%-48s %s\n", name, ok ? "PASS" : "FAIL");
+  if (!ok) failed++;
+}
+
+static void fresh_bus(const char* spec)
+{
+  sim_detach_all();
+  sim_attach_spec(spec);
+  i2cMaster_Bus_Init();
+  FRAM_Latch_Invalidate();
+}
+
+//**************** FramStream ******************//
+// Device stops answering while bytes are buffered: they must stay buffered
+static void test_stream_flush_nack(void)
+{
+  fresh_bus("mb85rc256v@50");
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  uint8_t* mem = sim_fram_memory(0x50);
+
+  FramStream out(fram, 0x100, 64);
+  out.print("ABCD");
+  sim_nack_fram(0x50, true);
+  out.flush();
+  check("stream: failed flush sets write error", out.getWriteError() != 0);
+  check("stream: failed flush counted", out.errors() == 1);
+  check("stream: failed flush writes nothing", memcmp(mem + 0x100, "ABCD", 4) != 0);
+  check("stream: clear refused while bytes are buffered", !out.clear());
+
+  sim_nack_fram(0x50, false);
+  out.clearWriteError();
+  out.flush();
+  check("stream: retried flush writes buffered bytes", memcmp(mem + 0x100, "ABCD", 4) == 0);
+  check("stream: retried flush has no write error", out.getWriteError() == 0);
+}
+
+//**************** Address Latch ******************//
+// Functions without device argument on FM24CL16B: 8-bit word address and
+// no page bits, same call must read same byte whatever was read before
+static void test_latch_8bit_no_capacity(void)
+{
+  fresh_bus("fm24cl16b@50");
+  i2cMaster_Init(0x50);
+  FRAM_Word_Adr(0);
+  uint8_t* mem = sim_fram_memory(0x50);
+  mem[0x000] = 0xA0;
+  mem[0x0FF] = 0xAF;
+  mem[0x100] = 0xB0;
+
+  FRAM_Latch_Invalidate();
+  uint8_t cold = FRAM_Read(0x100);
+  FRAM_Read(0xFF);
+  uint8_t after = FRAM_Read(0x100);
+  check("latch: FRAM_Read(0x100) after FRAM_Read(0xFF)", after == cold);
+
+  FRAM_Read(0xFE);
+  uint32_t repeats = sim_bus_stats().rep_starts;
+  uint8_t hit = FRAM_Read(0xFF);
+  check("latch: FRAM_Read(0xFF) after FRAM_Read(0xFE) reads current address",
+        hit == 0xAF && sim_bus_stats().rep_starts == repeats);
+}
+
+//**************** Mixed Devices ******************//
+// 16-bit and 8-bit word address handles on one bus, 8-bit chip past page 0
+static void test_mixed_devices(void)
+{
+  fresh_bus("mb85rc256v@50,fm24cl04b@54");
+  FramDevice fram1 = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  FramDevice fram3 = FRAM_Device(0x54, 0, FM24CL04B_SIZE);
+
+  sim_reset_stats();
+  FRAM_Write(fram1, 0x160, '1');
+  FRAM_Write(fram3, 0x160, '3');
+  check("mixed: 16-bit device written at 0x160", sim_fram_memory(0x50)[0x160] == '1');
+  check("mixed: 8-bit device written at 0x160", sim_fram_memory(0x54)[0x160] == '3');
+  check("mixed: 8-bit page 1 uses slave address 0x55",
+        (sim_bus_stats().sla_used[0x55 >> 3] & (1 << (0x55 & 0x07))) != 0);
+  check("mixed: reads back both devices",
+        FRAM_Read(fram1, 0x160) == '1' && FRAM_Read(fram3, 0x160) == '3');
+}
+
+//**************** Key-Value Store ******************//
+// Device stops answering: lookups report an error, not a missing key
+static void test_kv_bus_error(void)
+{
+  fresh_bus("mb85rc256v@50");
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  FramKV kv;
+  FRAM_KV_Begin(kv, fram, 0x2000, 512, 16);
+  FRAM_KV_Format(kv);
+  FRAM_KV_Put(kv, "name", "FRAM", 5);
+  uint16_t heap = kv.heap;
+
+  char val[8];
+  sim_nack_fram(0x50, true);
+  check("kv: get on bus error is not 'not found'",
+        FRAM_KV_Get(kv, "name", val, sizeof(val)) == FRAM_KV_ERROR);
+  check("kv: delete on bus error is not 'not found'",
+        FRAM_KV_Delete(kv, "name") == FRAM_KV_ERROR);
+  check("kv: put on bus error fails", !FRAM_KV_Put(kv, "name", "LONGER", 7));
+  check("kv: put on bus error stores nothing", kv.heap == heap);
+
+  sim_nack_fram(0x50, false);
+  check("kv: key still found after bus error",
+        FRAM_KV_Get(kv, "name", val, sizeof(val)) == 5 && strcmp(val, "FRAM") == 0);
+  check("kv: missing key is 'not found'",
+        FRAM_KV_Get(kv, "none", val, sizeof(val)) == FRAM_KV_NOT_FOUND);
+  check("kv: delete reports deleted, then not found",
+        FRAM_KV_Delete(kv, "name") == 1 && FRAM_KV_Delete(kv, "name") == 0);
+}
+
+//**************** Async Watchdog ******************//
+// Slave holds SDA, START never completes: wait gives up after stage budget
+static void test_async_watchdog(void)
+{
+  fresh_bus("mb85rc256v@50");
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  uint8_t buf[4];
+  FramAsync_Txn txn;
+
+  sim_hold_sda(5);                          // Freed by bus recovery
+  unsigned long us = micros();
+  FRAM_Async_Read(fram, &txn, 0x10, buf, sizeof(buf), 0);
+  uint8_t status = FRAM_Async_Wait(&txn);
+  us = micros() - us;
+  check("async: hung START ends with dead loop error",
+        status == FRAM_ASYNC_ERROR && txn.error == ASYNC_dead_loop);
+  check("async: watchdog within stage budget, not 1 ms",
+        us > FRAM_Async_Timeout_us() && us < 2 * FRAM_Async_Timeout_us() && us < 1000);
+
+  FRAM_Async_Read(fram, &txn, 0x10, buf, sizeof(buf), 0);
+  check("async: next transaction after recovery", FRAM_Async_Wait(&txn) == FRAM_ASYNC_DONE);
+}
+
+//**************** Line Cache ******************//
+// Device stops answering at flush: line stays dirty, no write back counted
+static void test_cache_writeback_nack(void)
+{
+  fresh_bus("mb85rc256v@50");
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  uint8_t* mem = sim_fram_memory(0x50);
+  FRAM_Cache_Invalidate();
+  unsigned long writebacks = Cache_Writebacks;
+
+  FRAM_Cache_Write(fram, 0xA0, 0x5A);
+  sim_nack_fram(0x50, true);
+  check("cache: failed write back reported", !FRAM_Cache_Flush());
+  check("cache: failed write back not counted",
+        Cache_Writebacks == writebacks && Cache_Errors == 1);
+
+  sim_nack_fram(0x50, false);
+  check("cache: line still dirty, next flush writes it",
+        FRAM_Cache_Flush() && mem[0xA0] == 0x5A && Cache_Writebacks == writebacks + 1);
+}
+
+//**************** CRC During Transfer ******************//
+// Blocks through FramChip and FramDevice, and across 8-bit page boundary
+static void test_crc_devices(void)
+{
+  fresh_bus("mb85rc256v@50");
+  typedef FramChip<MB85RC256V, 0x50> Chip;
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  uint8_t data[40], back[40];
+  for (uint8_t i = 0; i < sizeof(data); i++) data[i] = i * 7 + 1;
+
+  bool ok = FRAM_Write_Block_CRC<FramCRC32>(Chip(), 0x300, data, sizeof(data));
+  memset(back, 0, sizeof(back));
+  check("crc: FramChip block read back by FramDevice",
+        ok && FRAM_Read_Block_CRC<FramCRC32>(fram, 0x300, back, sizeof(back)) &&
+        memcmp(back, data, sizeof(data)) == 0);
+  check("crc: FramChip block read back by FramChip",
+        FRAM_Read_Block_CRC<FramCRC32>(Chip(), 0x300, back, sizeof(back)));
+
+  fresh_bus("fm24cl16b@50");                // Answers 0x50-0x57, alone on bus
+  FramDevice fm16 = FRAM_Device(0x50, 0, FM24CL16B_SIZE);
+  sim_reset_stats();
+  ok = FRAM_Write_Block_CRC<FramCRC16>(fm16, 0x1F0, data, sizeof(data));   // 42 bytes, 2 pages
+  uint8_t* mem = sim_fram_memory(0x50);
+  uint16_t crc = FRAM_CRC<FramCRC16>(data, sizeof(data));
+  check("crc: block split at page boundary",
+        ok && sim_bus_stats().starts == 2 && memcmp(mem + 0x1F0, data, sizeof(data)) == 0 &&
+        mem[0x218] == (uint8_t)crc && mem[0x219] == (uint8_t)(crc >> 8));
+
+  uint16_t stream = FramCRC16::init;
+  check("crc: streaming read across page boundary",
+        FRAM_Read_Buffer_CRC<FramCRC16>(fm16, 0x1F0, back, sizeof(back), stream) &&
+        FramCRC16::Final(stream) == crc);
+}
+
+//**************** Write Combining ******************//
+// Write which fills the buffer sends it, no need to wait for the next one
+static void test_combine_full_flush(void)
+{
+  fresh_bus("mb85rc256v@50");
+  FramDevice fram = FRAM_Device(0x50, 1, MB85RC256V_SIZE);
+  uint8_t* mem = sim_fram_memory(0x50);
+
+  for (uint8_t i = 0; i < FRAM_COMBINE_SIZE; i++) FRAM_Write_Combined(fram, 0x400 + i, 0x80 + i);
+  check("combine: full buffer written by filling write",
+        Combine_Count == 0 && mem[0x400] == 0x80 &&
+        mem[0x400 + FRAM_COMBINE_SIZE - 1] == 0x80 + FRAM_COMBINE_SIZE - 1);
+
+  unsigned long errors = Combine_Errors;
+  for (uint8_t i = 0; i < FRAM_COMBINE_SIZE - 1; i++) FRAM_Write_Combined(fram, 0x500 + i, 0x40 + i);
+  sim_nack_fram(0x50, true);
+  check("combine: filling write keeps byte when flush fails",
+        FRAM_Write_Combined(fram, 0x500 + FRAM_COMBINE_SIZE - 1, 0x5F) &&
+        Combine_Count == FRAM_COMBINE_SIZE && Combine_Errors == errors + 1);
+  sim_nack_fram(0x50, false);
+  check("combine: full run flushed on retry",
+        FRAM_Combine_Flush() && Combine_Count == 0 && mem[0x500 + FRAM_COMBINE_SIZE - 1] == 0x5F);
+}
+
+int main(void)
+{
+  test_stream_flush_nack();
+  test_latch_8bit_no_capacity();
+  test_mixed_devices();
+  test_kv_bus_error();
+  test_async_watchdog();
+  test_cache_writeback_nack();
+  test_crc_devices();
+  test_combine_full_flush();
+
+  printf("%s\n", failed ? "FAILED" : "ALL PASSED");
+  return failed ? 1 : 0;
+}
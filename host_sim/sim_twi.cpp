@@ -0,0 +1,593 @@
+/*
+    Host TWI Simulator
+    ------------------
+    Source file name - "sim_twi.cpp"
+
+    Description:
+    Bus model behind the TWI register proxies. A write to TWCR with TWINT set
+    starts one bus action (START, STOP, address byte, data byte) which finishes
+    after its bus time has elapsed on the simulated clock. TWINT (or the
+    clearing of TWSTO) only becomes visible once the CPU has spent that time
+    polling, so busy-wait loops and timeouts cost what they would on the MCU.
+
+    When the sketch defines ISR(TWI_vect), an interval timer signal stands in
+    for the asynchronous interrupt: if the CPU is running sketch code (not
+    inside the simulator) the pending bus action is completed and the ISR is
+    dispatched, like a real interrupt arriving between two instructions.
+
+    Date: 17 Oct 2026
+*/
+
+#include <stdio.h>
+#include <string.h>
+#include <ctype.h>
+#include <signal.h>
+#include <sys/time.h>
+
+#include "Arduino.h"
+
+SimTwiReg TWCR(SIM_TWCR);
+SimTwiReg TWSR(SIM_TWSR);
+SimTwiReg TWDR(SIM_TWDR);
+SimTwiReg TWBR(SIM_TWBR);
+SimSreg SREG;
+
+SimPortReg DDRC(SIM_DDRC);
+SimPortReg PORTC(SIM_PORTC);
+SimPortReg PINC(SIM_PINC);
+volatile uint8_t DDRD = 0, PORTD = 0, PIND = (1 << PIND0) | (1 << PIND1);
+volatile uint8_t TCCR1A = 0, TCCR1B = 0;
+SimTimer16 TCNT1;
+
+extern "C" void sim_vector_TWI(void) __attribute__((weak));
+
+//**************** TWI Status Codes ******************//
+#define ST_START          0x08
+#define ST_REP_START      0x10
+#define ST_MTX_ADR_ACK    0x18
+#define ST_MTX_ADR_NACK   0x20
+#define ST_MTX_DATA_ACK   0x28
+#define ST_MTX_DATA_NACK  0x30
+#define ST_MRX_ADR_ACK    0x40
+#define ST_MRX_ADR_NACK   0x48
+#define ST_MRX_DATA_ACK   0x50
+#define ST_MRX_DATA_NACK  0x58
+#define ST_NO_INFO        0xF8
+#define ST_BUS_ERROR      0x00
+
+#define SIM_MAX_DEVICES   8
+
+//**************** Device Model ******************//
+struct SimFram {
+  bool used;
+  SimFramType type;
+  uint8_t sla;          // 7-bit base address
+  uint8_t sla_mask;     // Slave address bits compared
+  bool adr16;           // 16-bit word address
+  uint32_t size;
+  uint32_t latch;       // Internal address latch
+  uint8_t adr_bytes;    // Word address bytes received in this write
+  bool nack;            // Does not answer its slave address (unpowered, removed)
+  uint8_t mem[32768];
+};
+
+static SimFram devices[SIM_MAX_DEVICES];
+
+//**************** Peripheral State ******************//
+enum BusPhase {
+  BUS_IDLE = 0,       // No transaction on the bus
+  BUS_ADDRESS,        // START sent, next byte is SLA+R/W
+  BUS_WRITE,          // Addressed for write
+  BUS_READ,           // Addressed for read
+  BUS_DEAD            // Addressed slave NACKed, waiting for STOP
+};
+
+enum PendingAction {
+  PEND_NONE = 0,
+  PEND_TWINT,         // Set TWINT when finished
+  PEND_STOP           // Clear TWSTO when finished
+};
+
+static uint8_t reg_twcr = 0;
+static uint8_t reg_twsr = ST_NO_INFO;
+static uint8_t reg_twdr = 0xFF;
+static uint8_t reg_twbr = 0;
+
+static BusPhase phase = BUS_IDLE;
+static SimFram* active = 0;
+static uint8_t active_page = 0;       // Slave address page bits of the transaction (SLA+W)
+
+static PendingAction pending = PEND_NONE;
+static uint64_t pending_at = 0;
+static uint8_t pending_twsr = ST_NO_INFO;
+static uint8_t pending_twdr = 0xFF;
+
+static uint64_t now_cycles = 0;
+static bool irq_enabled = true;       // Arduino core enables interrupts in init()
+static bool in_isr = false;
+
+static SimBusStats stats;
+
+static uint8_t reg_ddrc = 0;
+static uint8_t reg_portc = 0;
+static uint16_t sda_hold = 0;         // SCL clocks a slave still holds SDA low
+static bool scl_was_high = true;
+
+// Nesting depth of simulator calls, interrupt timer stays out while non-zero
+static volatile sig_atomic_t sim_depth = 0;
+
+struct SimGuard {
+  SimGuard() { sim_depth++; }
+  ~SimGuard() { sim_depth--; }
+};
+
+//**************** Helpers ******************//
+static uint32_t scl_period(void)
+{
+  static const uint8_t ps_shift[4] = {0, 2, 4, 6};
+  return 16 + 2 * (uint32_t)reg_twbr * (1UL << ps_shift[reg_twsr & 0x03]);
+}
+
+static void bus_time(uint32_t periods)
+{
+  uint32_t cycles = periods * scl_period();
+  stats.scl_periods += periods;
+  stats.cycles += cycles;
+  pending_at = now_cycles + cycles;
+}
+
+static void dispatch_isr(void)
+{
+  if (in_isr || !irq_enabled || !sim_vector_TWI) return;
+  if (!(reg_twcr & (1 << TWIE)) || !(reg_twcr & (1 << TWINT))) return;
+  in_isr = true;
+  irq_enabled = false;
+  sim_vector_TWI();
+  irq_enabled = true;
+  in_isr = false;
+}
+
+static void update(void)
+{
+  if (pending != PEND_NONE && now_cycles >= pending_at) {
+    if (pending == PEND_TWINT) {
+      reg_twsr = (reg_twsr & 0x03) | pending_twsr;
+      reg_twdr = pending_twdr;
+      reg_twcr |= (1 << TWINT);
+    }
+    else {
+      reg_twsr = (reg_twsr & 0x03) | ST_NO_INFO;
+      reg_twcr &= ~(1 << TWSTO);
+    }
+    pending = PEND_NONE;
+  }
+  dispatch_isr();
+}
+
+static SimFram* find_device(uint8_t sla7)
+{
+  for (uint8_t i = 0; i < SIM_MAX_DEVICES; i++) {
+    if (devices[i].used && (sla7 & devices[i].sla_mask) == devices[i].sla) return &devices[i];
+  }
+  return 0;
+}
+
+static uint32_t device_address(SimFram* dev)
+{
+  return dev->latch % dev->size;
+}
+
+//**************** Bus Lines ******************//
+static bool pin_driven_low(uint8_t pin)
+{
+  return (reg_ddrc & (1 << pin)) && !(reg_portc & (1 << pin));
+}
+
+static uint8_t line_levels(void)
+{
+  uint8_t pins = 0;
+  if (!pin_driven_low(PINC4) && sda_hold == 0) pins |= (1 << PINC4);
+  if (!pin_driven_low(PINC5)) pins |= (1 << PINC5);
+  return pins;
+}
+
+// Holding slave shifts out one bit per SCL clock (low -> high)
+static void lines_changed(void)
+{
+  bool scl_high = !pin_driven_low(PINC5);
+  if (scl_high && !scl_was_high && sda_hold > 0) sda_hold--;
+  scl_was_high = scl_high;
+}
+
+//**************** Bus Actions ******************//
+static void act_start(void)
+{
+  if (sda_hold > 0) {
+    // Bus not free, TWI keeps waiting and TWINT stays clear
+    pending = PEND_NONE;
+    return;
+  }
+  if (phase == BUS_IDLE) {
+    stats.starts++;
+    pending_twsr = ST_START;
+  }
+  else {
+    stats.rep_starts++;
+    pending_twsr = ST_REP_START;
+  }
+  phase = BUS_ADDRESS;
+  active = 0;
+  pending_twdr = reg_twdr;
+  pending = PEND_TWINT;
+  bus_time(1);
+}
+
+static void act_stop(void)
+{
+  stats.stops++;
+  phase = BUS_IDLE;
+  active = 0;
+  pending = PEND_STOP;
+  bus_time(1);
+}
+
+static void act_byte(bool ack)
+{
+  uint8_t data = reg_twdr;
+  pending_twdr = data;
+  pending = PEND_TWINT;
+  bus_time(9);
+
+  switch (phase) {
+    case BUS_ADDRESS: {
+      stats.sla_bytes++;
+      bool rd = data & 0x01;
+      active = find_device(data >> 1);
+      if (active && active->nack) active = 0;
+      if (!active) {
+        stats.nacks++;
+        pending_twsr = rd ? ST_MRX_ADR_NACK : ST_MTX_ADR_NACK;
+        phase = BUS_DEAD;
+        return;
+      }
+      stats.sla_used[data >> 4] |= 1 << ((data >> 1) & 0x07);
+      active_page = (data >> 1) & ~active->sla_mask & 0x07;   // FM24CLxx page bits, used with word address
+      active->adr_bytes = 0;
+      pending_twsr = rd ? ST_MRX_ADR_ACK : ST_MTX_ADR_ACK;
+      phase = rd ? BUS_READ : BUS_WRITE;
+      break;
+    }
+
+    case BUS_WRITE: {
+      stats.data_bytes++;
+      uint8_t adr_len = active->adr16 ? 2 : 1;
+      if (active->adr_bytes < adr_len) {
+        if (active->adr16 && active->adr_bytes == 0) {
+          active->latch = ((uint32_t)data << 8);
+        }
+        else if (active->adr16) {
+          active->latch |= data;
+        }
+        else {
+          active->latch = ((uint32_t)active_page << 8) | data;    // Page from SLA+W
+        }
+        active->adr_bytes++;
+      }
+      else {
+        uint32_t adr = device_address(active);
+        active->mem[adr] = data;
+        active->latch = (adr + 1) % active->size;   // Rolls over into next page
+      }
+      pending_twsr = ST_MTX_DATA_ACK;
+      break;
+    }
+
+    case BUS_READ: {
+      stats.data_bytes++;
+      uint32_t adr = device_address(active);
+      pending_twdr = active->mem[adr];
+      active->latch = (adr + 1) % active->size;
+      if (ack) {
+        pending_twsr = ST_MRX_DATA_ACK;
+      }
+      else {
+        stats.nacks++;
+        pending_twsr = ST_MRX_DATA_NACK;
+      }
+      break;
+    }
+
+    default:
+      // Clocking bytes without an addressed slave
+      pending_twdr = 0xFF;
+      pending_twsr = ST_BUS_ERROR;
+      break;
+  }
+}
+
+static void write_twcr(uint8_t value)
+{
+  if (!(value & (1 << TWEN))) {
+    // Disabling TWI aborts any transfer in progress
+    reg_twcr = value & ~((1 << TWINT) | (1 << TWSTO));
+    phase = BUS_IDLE;
+    active = 0;
+    pending = PEND_NONE;
+    return;
+  }
+
+  bool clear_int = value & (1 << TWINT);
+  reg_twcr = (reg_twcr & (1 << TWINT)) | (value & ~(1 << TWINT));
+  if (!clear_int) return;
+
+  reg_twcr &= ~(1 << TWINT);
+  if (value & (1 << TWSTO)) {
+    act_stop();
+    if (value & (1 << TWSTA)) {
+      // STOP followed by START, the start is issued once the stop completes
+      now_cycles = pending_at;
+      update();
+      act_start();
+    }
+  }
+  else if (value & (1 << TWSTA)) {
+    act_start();
+  }
+  else {
+    act_byte(value & (1 << TWEA));
+  }
+}
+
+//**************** Register Proxy ******************//
+SimTwiReg::operator uint8_t() const
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  switch (id_) {
+    case SIM_TWCR: return reg_twcr;
+    case SIM_TWSR: return reg_twsr;
+    case SIM_TWDR: return reg_twdr;
+    default:       return reg_twbr;
+  }
+}
+
+SimTwiReg& SimTwiReg::operator=(uint8_t value)
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  switch (id_) {
+    case SIM_TWCR: write_twcr(value); break;
+    case SIM_TWSR: reg_twsr = (reg_twsr & 0xF8) | (value & 0x03); break;
+    case SIM_TWDR: reg_twdr = value; break;
+    default:       reg_twbr = value; break;
+  }
+  return *this;
+}
+
+SimPortReg::operator uint8_t() const
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  switch (id_) {
+    case SIM_DDRC:  return reg_ddrc;
+    case SIM_PORTC: return reg_portc;
+    default:        return line_levels();
+  }
+}
+
+SimPortReg& SimPortReg::operator=(uint8_t value)
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  switch (id_) {
+    case SIM_DDRC:  reg_ddrc = value; break;
+    case SIM_PORTC: reg_portc = value; break;
+    default:        reg_portc ^= value; break;    // Writing PINx toggles PORTx
+  }
+  lines_changed();
+  return *this;
+}
+
+//**************** Timer1 ******************//
+static uint32_t timer1_prescale(void)
+{
+  static const uint16_t prescale[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+  return prescale[TCCR1B & 0x07];
+}
+
+SimTimer16::operator uint16_t() const
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  uint32_t ps = timer1_prescale();
+  if (ps == 0) return start_;
+  return (uint16_t)(start_ + (now_cycles - base_) / ps);
+}
+
+SimTimer16& SimTimer16::operator=(uint16_t value)
+{
+  SimGuard guard;
+  now_cycles += SIM_REG_CYCLES;
+  update();
+  start_ = value;
+  base_ = now_cycles;
+  return *this;
+}
+
+//**************** Bus Line API ******************//
+void sim_hold_sda(uint16_t scl_clocks)
+{
+  sda_hold = scl_clocks;
+}
+
+bool sim_sda_held(void)
+{
+  return sda_hold > 0;
+}
+
+//**************** Device API ******************//
+bool sim_attach_fram(SimFramType type, uint8_t sla)
+{
+  for (uint8_t i = 0; i < SIM_MAX_DEVICES; i++) {
+    if (devices[i].used) continue;
+    SimFram* dev = &devices[i];
+    memset(dev, 0, sizeof(*dev));
+    dev->used = true;
+    dev->type = type;
+    if (type == SIM_FM24CL16B) {
+      dev->sla = sla & 0x78;
+      dev->sla_mask = 0x78;
+      dev->adr16 = false;
+      dev->size = 2048;
+    }
+    else if (type == SIM_FM24CL04B) {
+      dev->sla = sla & 0x7E;
+      dev->sla_mask = 0x7E;
+      dev->adr16 = false;
+      dev->size = 512;
+    }
+    else {
+      dev->sla = sla & 0x7F;
+      dev->sla_mask = 0x7F;
+      dev->adr16 = true;
+      dev->size = (type == SIM_MB85RC64) ? 8192 : 32768;
+    }
+    return true;
+  }
+  return false;
+}
+
+bool sim_attach_spec(const char* spec)
+{
+  char name[16];
+  while (spec && *spec) {
+    uint8_t n = 0;
+    while (*spec && *spec != '@' && n < sizeof(name) - 1) name[n++] = tolower(*spec++);
+    name[n] = '\0';
+    if (*spec != '@') return false;
+    uint8_t sla = (uint8_t)strtoul(spec + 1, (char**)&spec, 16);
+
+    SimFramType type;
+    if (!strcmp(name, "fm24cl16b")) type = SIM_FM24CL16B;
+    else if (!strcmp(name, "fm24cl04b")) type = SIM_FM24CL04B;
+    else if (!strcmp(name, "mb85rc64")) type = SIM_MB85RC64;
+    else if (!strcmp(name, "mb85rc256v")) type = SIM_MB85RC256V;
+    else return false;
+
+    if (!sim_attach_fram(type, sla)) return false;
+    if (*spec == ',') spec++;
+  }
+  return true;
+}
+
+void sim_detach_all(void)
+{
+  memset(devices, 0, sizeof(devices));
+}
+
+uint8_t* sim_fram_memory(uint8_t sla)
+{
+  SimFram* dev = find_device(sla);
+  return dev ? dev->mem : 0;
+}
+
+bool sim_nack_fram(uint8_t sla, bool nack)
+{
+  SimFram* dev = find_device(sla);
+  if (!dev) return false;
+  dev->nack = nack;
+  return true;
+}
+
+//**************** Clock API ******************//
+uint64_t sim_cycles(void)
+{
+  return now_cycles;
+}
+
+void sim_advance(uint32_t cycles)
+{
+  SimGuard guard;
+  now_cycles += cycles;
+  update();
+}
+
+void sim_set_irq(bool enabled)
+{
+  SimGuard guard;
+  now_cycles += 1;
+  irq_enabled = enabled;
+  update();
+}
+
+bool sim_irq_enabled(void)
+{
+  return irq_enabled;
+}
+
+const SimBusStats& sim_bus_stats(void)
+{
+  return stats;
+}
+
+void sim_reset_stats(void)
+{
+  memset(&stats, 0, sizeof(stats));
+}
+
+static void irq_timer_tick(int)
+{
+  if (sim_depth) return;
+  sim_depth++;
+  // Sketch code ran freely until the pending bus action finished
+  if (pending != PEND_NONE && pending_at > now_cycles) now_cycles = pending_at;
+  update();
+  sim_depth--;
+}
+
+void sim_start_irq_timer(void)
+{
+  if (!sim_vector_TWI) return;
+
+  struct sigaction sa;
+  memset(&sa, 0, sizeof(sa));
+  sa.sa_handler = irq_timer_tick;
+  sa.sa_flags = SA_RESTART;
+  sigaction(SIGALRM, &sa, 0);
+
+  struct itimerval tv;
+  tv.it_interval.tv_sec = 0;
+  tv.it_interval.tv_usec = SIM_IRQ_TIMER_US;
+  tv.it_value = tv.it_interval;
+  setitimer(ITIMER_REAL, &tv, 0);
+}
+
+//**************** Arduino Time ******************//
+unsigned long millis(void)
+{
+  sim_advance(SIM_REG_CYCLES);
+  return (unsigned long)(now_cycles / (F_CPU / 1000UL));
+}
+
+unsigned long micros(void)
+{
+  sim_advance(SIM_REG_CYCLES);
+  return (unsigned long)(now_cycles / (F_CPU / 1000000UL));
+}
+
+void delayMicroseconds(unsigned int us)
+{
+  uint64_t end = now_cycles + (uint64_t)us * (F_CPU / 1000000UL);
+  while (now_cycles < end) sim_advance(16);
+}
+
+void delay(unsigned long ms)
+{
+  uint64_t end = now_cycles + (uint64_t)ms * (F_CPU / 1000UL);
+  while (now_cycles < end) sim_advance(64);
+}
@@ -0,0 +1,148 @@
+/*
+    Host TWI Simulator
+    ------------------
+    Header file name - "sim_twi.h"
+
+    Description:
+    Simulated ATmega328p TWI peripheral and FRAM devices for building the
+    driver headers on a Linux host. TWCR/TWSR/TWDR/TWBR are register proxies
+    that drive a bus model, and every bus event advances a simulated CPU
+    clock, so millis()/micros() and the driver timeouts behave as on the MCU.
+
+    Timing model:
+      SCL period = 16 + 2 * TWBR * 4^TWPS   (CPU cycles, from datasheet)
+      START/REPEAT/STOP = 1 SCL period, byte + ACK = 9 SCL periods
+      Every register access costs SIM_REG_CYCLES CPU cycles.
+
+    Bus lines:
+      PC4 (SDA) and PC5 (SCL) follow DDRC/PORTC as open-drain lines, so the
+      driver's bus recovery can be run against a slave holding SDA low
+      (sim_hold_sda()).
+
+    Devices:
+      FM24CL16B  - 2 KB, 8-bit word address, page bits A8..A10 in slave address
+                   (answers on all 8 slave addresses of its base, e.g. 0x50-0x57).
+                   Page bits take effect with the word address of a write,
+                   current-address reads go on from the 11-bit address latch.
+      FM24CL04B  - 512 B, 8-bit word address, page bit A8 in slave address
+                   (answers on 2 slave addresses, e.g. 0x54-0x55).
+      MB85RC64   - 8 KB, 16-bit word address
+      MB85RC256V - 32 KB, 16-bit word address
+
+    Date: 17 Oct 2026
+*/
+
+#ifndef SIM_TWI_H
+#define SIM_TWI_H
+
+#include <stdint.h>
+
+#define SIM_REG_CYCLES      4     // CPU cycles charged for each register access
+#define SIM_IRQ_TIMER_US    20    // Host interval for asynchronous TWI interrupt delivery
+
+//**************** Register Proxy ******************//
+class SimTwiReg {
+  public:
+    explicit SimTwiReg(uint8_t id) : id_(id) {}
+    operator uint8_t() const;
+    SimTwiReg& operator=(uint8_t value);
+    SimTwiReg& operator|=(uint8_t value) { return *this = (uint8_t)(*this | value); }
+    SimTwiReg& operator&=(uint8_t value) { return *this = (uint8_t)(*this & value); }
+
+  private:
+    SimTwiReg(const SimTwiReg&);
+    SimTwiReg& operator=(const SimTwiReg&);
+    uint8_t id_;
+};
+
+// 16-bit Timer/Counter1 (TCNT1), counts simulated CPU cycles / TCCR1B prescaler
+class SimTimer16 {
+  public:
+    operator uint16_t() const;
+    SimTimer16& operator=(uint16_t value);
+
+  private:
+    uint64_t base_;
+    uint16_t start_;
+};
+
+enum SimRegId {
+  SIM_TWCR = 0,
+  SIM_TWSR,
+  SIM_TWDR,
+  SIM_TWBR
+};
+
+// Port C registers, PC4 = SDA and PC5 = SCL are open-drain bus lines.
+// A line is low while the pin drives it (DDR set, PORT clear) or a slave
+// holds it, PINC reads the line levels.
+class SimPortReg {
+  public:
+    explicit SimPortReg(uint8_t id) : id_(id) {}
+    operator uint8_t() const;
+    SimPortReg& operator=(uint8_t value);
+    SimPortReg& operator|=(uint8_t value) { return *this = (uint8_t)(*this | value); }
+    SimPortReg& operator&=(uint8_t value) { return *this = (uint8_t)(*this & value); }
+
+  private:
+    SimPortReg(const SimPortReg&);
+    SimPortReg& operator=(const SimPortReg&);
+    uint8_t id_;
+};
+
+enum SimPortId {
+  SIM_DDRC = 0,
+  SIM_PORTC,
+  SIM_PINC
+};
+
+//**************** Bus Statistics ******************//
+struct SimBusStats {
+  uint32_t starts;        // START conditions
+  uint32_t rep_starts;    // Repeated START conditions
+  uint32_t stops;         // STOP conditions
+  uint32_t sla_bytes;     // SLA+W / SLA+R bytes
+  uint32_t data_bytes;    // Word address and data bytes
+  uint32_t nacks;         // NACKs seen on the bus (address or last read)
+  uint8_t sla_used[16];   // 7-bit slave addresses acknowledged (bit per address)
+  uint64_t scl_periods;   // Bus time in SCL periods
+  uint64_t cycles;        // Bus time in CPU cycles
+};
+
+//**************** FRAM Device Models ******************//
+enum SimFramType {
+  SIM_FM24CL16B = 0,
+  SIM_MB85RC64,
+  SIM_MB85RC256V,
+  SIM_FM24CL04B
+};
+
+// Attach a device model at 7-bit base address, returns 0 if the slot is taken
+bool sim_attach_fram(SimFramType type, uint8_t sla);
+// Attach devices from a spec string, e.g. "mb85rc256v@50,fm24cl04b@54"
+bool sim_attach_spec(const char* spec);
+void sim_detach_all(void);
+// Raw device memory (indexed by linear address) for inspection
+uint8_t* sim_fram_memory(uint8_t sla);
+// Device stops answering its slave address (NACK) until called with 0
+bool sim_nack_fram(uint8_t sla, bool nack);
+
+//**************** Bus Lines ******************//
+// Slave holds SDA low for the next scl_clocks SCL clocks (0 = release),
+// as after a reset in the middle of a read. START cannot be sent while
+// SDA is held, the TWI waits for a free bus and TWINT is not set.
+void sim_hold_sda(uint16_t scl_clocks);
+bool sim_sda_held(void);
+
+//**************** Clock and Interrupts ******************//
+uint64_t sim_cycles(void);
+void sim_advance(uint32_t cycles);
+void sim_set_irq(bool enabled);
+bool sim_irq_enabled(void);
+// Deliver ISR(TWI_vect) asynchronously while sketch code spins (no-op without ISR)
+void sim_start_irq_timer(void);
+
+const SimBusStats& sim_bus_stats(void);
+void sim_reset_stats(void);
+
+#endif